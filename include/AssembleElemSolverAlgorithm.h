@@ -15,6 +15,9 @@
 #include<CopyAndInterleave.h>
 #include<FieldTypeDef.h>
 
+#include <algorithm>
+#include <vector>
+
 namespace stk {
 namespace mesh {
 class Part;
@@ -23,6 +26,7 @@ class Topology;
 }
 
 class MasterElement;
+class LinearSystem;
 
 int
 calculate_shared_mem_bytes_per_thread(int lhsSize, int rhsSize, int scratchIdsSize, int nDim,
@@ -41,6 +45,8 @@ public:
   virtual ~AssembleElemSolverAlgorithm() {}
   virtual void initialize_connectivity();
   virtual void execute();
+  /** Element kernels only; face and node rank algorithms run whole*/
+  virtual bool assembles_by_region() const { return entityRank_ == stk::topology::ELEMENT_RANK; }
 
   template<typename LambdaFunction>
   void run_algorithm(stk::mesh::BulkData& bulk_data, LambdaFunction lambdaFunc)
@@ -55,7 +61,8 @@ public:
    stk::mesh::Selector elemSelector =
            meta_data.locally_owned_part()
          & stk::mesh::selectUnion(partVec_)
-         & !realm_.get_inactive_selector();
+         & !realm_.get_inactive_selector()
+         & realm_.assembly_region_selector(region_);
  
    stk::mesh::BucketVector const& elem_buckets =
            realm_.get_buckets(entityRank_, elemSelector );
@@ -81,6 +88,7 @@ public:
  
        for(int simdElemIndex=0; simdElemIndex<numSimdElems; ++simdElemIndex) {
          stk::mesh::Entity element = b[bktIndex*simdLen + simdElemIndex];
+         smdata.elems[simdElemIndex] = element;
          smdata.elemNodes[simdElemIndex] = bulk_data.begin_nodes(element);
          fill_pre_req_data(dataNeededByKernels_, bulk_data, element,
                            *smdata.prereqData[simdElemIndex], interleaveMEViews_);
@@ -97,11 +105,83 @@ public:
    });
   }
 
+  /** Same as run_algorithm, but sweeps the element colours of the linear system
+   *
+   *  Elements of one colour share no node, so the scatter of a colour needs no
+   *  atomics and the assembled system is bitwise reproducible for any thread count.
+   *  colorElems_[region_] must have been filled by fill_color_elements().
+   */
+  template<typename LambdaFunction>
+  void run_algorithm_colored(stk::mesh::BulkData& bulk_data, LambdaFunction lambdaFunc)
+  {
+    stk::mesh::MetaData& meta_data = bulk_data.mesh_meta_data();
+    const int lhsSize = rhsSize_*rhsSize_;
+    const int scratchIdsSize = rhsSize_;
+
+    const int bytes_per_team = 0;
+    const int bytes_per_thread = calculate_shared_mem_bytes_per_thread(lhsSize, rhsSize_, scratchIdsSize,
+                                                                       meta_data.spatial_dimension(), dataNeededByKernels_);
+
+    const size_t chunkSize = colorChunkSize_;
+    for ( const std::vector<stk::mesh::Entity>& elems : colorElems_[region_].elems ) {
+      const size_t numElems = elems.size();
+      const size_t numChunks = (numElems + chunkSize - 1)/chunkSize;
+
+      auto team_exec = get_team_policy(numChunks, bytes_per_team, bytes_per_thread);
+      Kokkos::parallel_for(team_exec, [&](const TeamHandleType& team)
+      {
+        SharedMemData smdata(team, bulk_data, dataNeededByKernels_, nodesPerEntity_, rhsSize_);
+
+        const size_t chunkBegin = team.league_rank()*chunkSize;
+        const size_t chunkLen = std::min(chunkSize, numElems - chunkBegin);
+        const size_t simdChunkLen = get_num_simd_groups(chunkLen);
+
+        Kokkos::parallel_for(Kokkos::TeamThreadRange(team, simdChunkLen), [&](const size_t& chunkIndex)
+        {
+          int numSimdElems = get_length_of_next_simd_group(chunkIndex, chunkLen);
+          smdata.numSimdElems = numSimdElems;
+
+          for(int simdElemIndex=0; simdElemIndex<numSimdElems; ++simdElemIndex) {
+            stk::mesh::Entity element = elems[chunkBegin + chunkIndex*simdLen + simdElemIndex];
+            smdata.elems[simdElemIndex] = element;
+            smdata.elemNodes[simdElemIndex] = bulk_data.begin_nodes(element);
+            fill_pre_req_data(dataNeededByKernels_, bulk_data, element,
+                              *smdata.prereqData[simdElemIndex], interleaveMEViews_);
+          }
+
+          copy_and_interleave(smdata.prereqData, numSimdElems, smdata.simdPrereqData, interleaveMEViews_);
+
+          if (!interleaveMEViews_) {
+            fill_master_element_views(dataNeededByKernels_, bulk_data, smdata.simdPrereqData);
+          }
+
+          lambdaFunc(smdata);
+        });
+      });
+    }
+  }
+
+  /** Sort the elements of this algorithm in region_ into the colours of the linear system
+   *
+   *  Only redone when the linear system was recreated or the mesh modified.
+   */
+  void fill_color_elements();
+
   ElemDataRequests dataNeededByKernels_;
   stk::mesh::EntityRank entityRank_;
   unsigned nodesPerEntity_;
   int rhsSize_;
   const bool interleaveMEViews_;
+
+  // elements of this algorithm per colour and assembly region; only used with
+  // use_element_coloring. Kept for the linear system and mesh state they were sorted for
+  struct ColorElements {
+    std::vector<std::vector<stk::mesh::Entity>> elems;
+    const LinearSystem * linsys{NULL};
+    size_t meshCount{0};
+  };
+  ColorElements colorElems_[NUM_ASSEMBLY_REGIONS];
+  static constexpr size_t colorChunkSize_ = 64;
 };
 
 #endif /* ASSEMBLEELEMSOLVERALGORITHM_H */
@@ -0,0 +1,52 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef ASSEMBLEHEATCONDMASSBUCKETALGORITHM_H
+#define ASSEMBLEHEATCONDMASSBUCKETALGORITHM_H
+
+#include<SolverAlgorithm.h>
+#include<FieldTypeDef.h>
+
+#include <vector>
+
+class stk::mesh::Part;
+class Realm;
+
+/** Solver algorithm for the lumped mass term of the heat conduction
+ * equation, bucket by bucket.
+ *
+ * Same contribution as HeatCondMassBackwardEulerNodeSuppAlg and
+ * HeatCondMassBDF2NodeSuppAlg inside AssembleNodeSolverAlgorithm, but the
+ * temperature states, density, specific heat and dual nodal volume are read
+ * as contiguous bucket arrays and the whole bucket is added to the diagonal
+ * and the rhs with one LinearSystem::sumIntoDiagonal call. Used for
+ * transient runs of the single dof heat conduction system.
+ */
+class AssembleHeatCondMassBucketAlgorithm : public SolverAlgorithm {
+public:
+    AssembleHeatCondMassBucketAlgorithm(
+        Realm &realm,
+        stk::mesh::Part *part,
+        EquationSystem *eqSystem,
+        const bool useBDF2);
+    virtual ~AssembleHeatCondMassBucketAlgorithm() {}
+    virtual void initialize_connectivity();
+    virtual void execute();
+
+private:
+    const bool useBDF2_;
+
+    ScalarFieldType * temperatureNm1_;
+    ScalarFieldType * temperatureN_;
+    ScalarFieldType * temperatureNp1_;
+    ScalarFieldType * density_;
+    ScalarFieldType * specificHeat_;
+    ScalarFieldType * dualNodalVolume_;
+
+    // diagonal and rhs of one bucket
+    std::vector<double> lhsBucket_;
+    std::vector<double> rhsBucket_;
+};
+
+#endif /* ASSEMBLEHEATCONDMASSBUCKETALGORITHM_H */
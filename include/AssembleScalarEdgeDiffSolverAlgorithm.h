@@ -0,0 +1,49 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef ASSEMBLESCALAREDGEDIFFSOLVERALGORITHM_H
+#define ASSEMBLESCALAREDGEDIFFSOLVERALGORITHM_H
+
+#include<SolverAlgorithm.h>
+#include<FieldTypeDef.h>
+
+class stk::mesh::Part;
+class Realm;
+
+/** Solver algorithm to compute the coefficients of the
+ * diffusion equation edge by edge.
+ *
+ * For linear tets and triangles every subcontrol surface belongs to
+ * exactly one edge, so the element scs area vectors can be summed once
+ * into the edge field edge_area_vector (ComputeGeometryInteriorAlgorithm).
+ * The flux through an edge is the two point flux along the edge plus a
+ * non-orthogonal correction from the nodal gradient dqdx, which gives a
+ * 2x2 contribution per edge instead of a dense element matrix.
+ *
+ * Activated by the solution option use_edges.
+ */
+class AssembleScalarEdgeDiffSolverAlgorithm : public SolverAlgorithm {
+public:
+    AssembleScalarEdgeDiffSolverAlgorithm(
+        Realm &realm,
+        stk::mesh::Part *part,
+        EquationSystem *eqSystem,
+        ScalarFieldType *scalarQ,
+        VectorFieldType *dqdx,
+        ScalarFieldType *diffFluxCoeff);
+    virtual ~AssembleScalarEdgeDiffSolverAlgorithm() {}
+    virtual void initialize_connectivity();
+    virtual void execute();
+    virtual bool assembles_by_region() const { return true; }
+
+private:
+    ScalarFieldType * scalarQ_;
+    VectorFieldType * dqdx_;
+    ScalarFieldType * diffFluxCoeff_;
+    VectorFieldType * coordinates_;
+    VectorFieldType * edgeAreaVec_;
+};
+
+#endif /* ASSEMBLESCALAREDGEDIFFSOLVERALGORITHM_H */
+
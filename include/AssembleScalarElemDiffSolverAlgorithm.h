@@ -26,11 +26,23 @@ public:
     virtual ~AssembleScalarElemDiffSolverAlgorithm() {}
     virtual void initialize_connectivity();
     virtual void execute();
+    virtual bool assembles_by_region() const { return true; }
+
+    /** When set, execute() also accumulates the Green-Gauss gradient of
+     * scalarQ into dqdx (interior contribution only). The caller zeroes dqdx
+     * before and adds the boundary terms and parallel sum afterwards.
+     */
+    bool computeNodalGradient_;
+    
+    /** Shifted shape functions for the fused gradient, as AssembleNodalGradElemAlgorithm*/
+    bool useShiftedNodalGradient_;
 
 private:
     ScalarFieldType * scalarQ_;
+    VectorFieldType * dqdx_;
     ScalarFieldType * diffFluxCoeff_;
     VectorFieldType * coordinates_;
+    ScalarFieldType * dualNodalVolume_;
     const bool shiftedGradOp_;
     
     // Execution related stuff
@@ -0,0 +1,52 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef ASYNCOUTPUTWRITER_H
+#define ASYNCOUTPUTWRITER_H
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+/** Runs output tasks (e.g. a restart step of the StkMeshIoBroker) on a writer thread
+ *
+ * At most one task is pending or running; submit() first waits for the
+ * previous one. The task must only read data the solver thread does not
+ * modify until the next wait(), e.g. snapshot fields, and must not make MPI
+ * calls; the database is defined on the solver thread beforehand. Every other
+ * use of the StkMeshIoBroker has to wait() first, Ioss is not thread safe.
+ *
+ * An exception of a task is rethrown on the solver thread by the next
+ * submit() or wait().
+ */
+class AsyncOutputWriter {
+public:
+    AsyncOutputWriter();
+    ~AsyncOutputWriter();
+
+    /** Hands task to the writer thread once the previous task has finished*/
+    void submit(std::function<void()> task);
+
+    /** Blocks until the writer thread is idle; returns the seconds waited*/
+    double wait();
+
+    /** Seconds the solver thread waited in submit() and wait()*/
+    double wait_time() const { return waitTime_; }
+
+private:
+    void run();
+
+    std::thread thread_;
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::function<void()> task_;
+    std::exception_ptr error_;
+    bool busy_;
+    bool shutdown_;
+    double waitTime_;
+};
+
+#endif /* ASYNCOUTPUTWRITER_H */
@@ -73,6 +73,12 @@ INSTANTIATE_POLY_TEMPLATE(ClassName,AlgTraitsQuadPHexPGL)         \
 #define INSTANTIATE_KERNEL_FACE_ELEMENT_2D_HO(ClassName)          \
 INSTANTIATE_POLY_TEMPLATE(ClassName,AlgTraitsEdgePQuadPGL)        \
 
+// topologies that currently have CVFEM master elements
+
+#define INSTANTIATE_KERNEL_CVFEM_P1(ClassName)                    \
+template class ClassName<AlgTraitsTet4>;                          \
+template class ClassName<AlgTraitsTri3_2D>;                       \
+
 // Instantiate the actual kernels
 
 #define INSTANTIATE_KERNEL(ClassName)                             \
@@ -18,6 +18,10 @@ public:
   ComputeGeometryInteriorAlgorithm(Realm &realm, stk::mesh::Part *part);
   ~ComputeGeometryInteriorAlgorithm();
   void execute();
+
+private:
+  /** Sums the scs area vectors of the elements into edge_area_vector (realm uses edges)*/
+  void assemble_edge_area_vector();
 };
 
 #endif /* COMPUTEGEOMETRYINTERIORALGORITHM_H */
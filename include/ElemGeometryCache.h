@@ -0,0 +1,80 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef ELEMGEOMETRYCACHE_H
+#define ELEMGEOMETRYCACHE_H
+
+#include <stk_mesh/base/Entity.hpp>
+
+#include <limits>
+#include <vector>
+
+class Realm;
+
+/** Opt-in cache of the element geometry used by the interior assembly loops
+ *
+ * For every locally owned interior element the subcontrol surface area
+ * vectors (scs_areav), the subcontrol surface gradient operator (dndx, from
+ * grad_op) and the subcontrol volumes (scv_volume) are stored in contiguous
+ * arrays. The cache is built once by Realm::compute_geometry and reused by
+ * the assembly algorithms instead of recomputing the geometry from the
+ * coordinates each nonlinear iteration. It must be invalidated whenever the
+ * coordinates change; Realm::compute_geometry does so for moving meshes.
+ *
+ * Activated by the solution option use_element_geometry_cache.
+ */
+class ElemGeometryCache {
+public:
+    ElemGeometryCache(Realm & realm);
+    ~ElemGeometryCache();
+
+    /** Computes and stores the geometry of all locally owned interior elements*/
+    void build();
+
+    /** Releases the cached data; accessors return NULL until the next build()*/
+    void invalidate();
+
+    bool is_valid() const { return isValid_; }
+
+    /** Cached scs area vectors of elem, numScsIp*nDim, or NULL if not cached*/
+    const double * scs_areav(stk::mesh::Entity elem) const;
+
+    /** Cached (unshifted) scs gradient operator of elem, numScsIp*nodesPerElement*nDim, or NULL*/
+    const double * dndx(stk::mesh::Entity elem) const;
+
+    /** Cached scv volumes of elem, numScvIp, or NULL if not cached*/
+    const double * scv_volume(stk::mesh::Entity elem) const;
+
+    /** Bytes held by the cache, including the element lookup table*/
+    size_t memory_bytes() const;
+
+    size_t num_elements() const { return offsets_.size(); }
+
+    double timerBuild_;
+
+private:
+    struct ElemOffsets {
+        size_t areav_;
+        size_t dndx_;
+        size_t scv_;
+    };
+
+    size_t slot(stk::mesh::Entity elem) const;
+
+    Realm & realm_;
+    bool isValid_;
+
+    // element local_offset -> slot into offsets_; INVALID_SLOT for non cached entities
+    std::vector<size_t> elemSlot_;
+    std::vector<ElemOffsets> offsets_;
+
+    std::vector<double> scsAreav_;
+    std::vector<double> dndx_;
+    std::vector<double> scvVolume_;
+
+    static const size_t INVALID_SLOT = std::numeric_limits<size_t>::max();
+};
+
+#endif /* ELEMGEOMETRYCACHE_H */
+
@@ -40,6 +40,18 @@ enum AlgorithmType{
     REF_PRESSURE = 15
 };
 
+/** Entities assembled by an algorithm that supports split assembly
+ *
+ *  ASSEMBLE_SHARED are the elements with a shared or boundary condition node,
+ *  ASSEMBLE_INTERIOR the others. See SolverAlgorithmDriver::execute_overlapped.
+ */
+enum AssemblyRegion {
+    ASSEMBLE_ALL = 0,
+    ASSEMBLE_SHARED = 1,
+    ASSEMBLE_INTERIOR = 2,
+    NUM_ASSEMBLY_REGIONS = 3
+};
+
 enum EquationType {
     EQ_MOMENTUM = 0,
     EQ_CONTINUITY = 1,
@@ -18,6 +18,8 @@ class SolverAlgorithmDriver;
 class InitialCondition;
 class EquationSystems;
 class LinearSystem;
+class TpetraLinearSystem;
+class MatrixFreeOperator;
 
 struct stk::topology;
 class stk::mesh::FieldBase;
@@ -67,6 +69,12 @@ public:
     virtual void provide_output() {}
     virtual void pre_timestep_work();
     virtual void reinitialize_linear_system() {}
+    
+    /** Operator for a matrix_free linear solver; NULL if the system has none
+     *
+     *  Called by TpetraLinearSystem::finalizeLinearSystem, which takes ownership.
+     */
+    virtual MatrixFreeOperator * create_matrix_free_operator(const TpetraLinearSystem & linsys) { return NULL; }
     virtual void dump_eq_time();
     virtual double provide_scaled_norm();
     virtual double provide_norm();
@@ -84,6 +92,9 @@ public:
     
     void update_iteration_statistics(const int & iters);
 
+    /** Accumulate |b - A x0|/|b| of a solve started from a non-zero initial guess*/
+    void update_initial_guess_statistics(const double & residualRatio);
+
     bool bc_data_specified(const UserData&, std::string &name);
     
     virtual void post_converged_work() {}
@@ -113,6 +124,10 @@ public:
     double maxLinearIterations_;
     double minLinearIterations_;
     int nonLinearIterationCount_;
+    int numPrecondComputes_;
+    double avgInitialGuessResidual_;
+    double maxInitialGuessResidual_;
+    int initialGuessCount_;
     bool reportLinearIterations_;
     bool firstTimeStepSolve_;
     bool edgeNodalGradient_;
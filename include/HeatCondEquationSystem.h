@@ -19,6 +19,7 @@ class AlgorithmDriver;
 class EquationSystems;
 class TpetraLinearSystem;
 class ProjectedNodalGradientEquationSystem;
+class AssembleScalarElemDiffSolverAlgorithm;
 
 /** Specific implementation of the head conduction equation system.
  *
@@ -88,6 +89,18 @@ public:
      *       but has to be removed safely
      */
     void compute_projected_nodal_gradient();
+
+    /** Boundary terms and parallel sum of a nodal gradient whose interior
+     *  part was accumulated by the fused diffusion algorithm
+     */
+    void complete_fused_nodal_gradient();
+
+    /** Is the assembled LHS the same as in the last assembly
+     *
+     *  True for constant material properties on a static mesh as long as
+     *  the time step and the time integrator coefficient do not change.
+     */
+    bool lhs_is_unchanged();
     
     /** Finishes initialization of solver algorithm and linear system*/
     void initialize();
@@ -95,6 +108,9 @@ public:
     /** Deletes linear solver and linear system an creates new ones*/
     void reinitialize_linear_system();
     
+    /** Element-by-element diffusion operator for a matrix_free linear solver*/
+    MatrixFreeOperator * create_matrix_free_operator(const TpetraLinearSystem & linsys);
+    
     /** Copy fields to a new timestep?
      *
      * @note Seems like this isn't used anywhere
@@ -122,8 +138,16 @@ public:
     VectorFieldType *edgeAreaVec_;
  
     AssembleNodalGradAlgorithmDriver * assembleNodalGradAlgDriver_;
+    
+    // interior diffusion algorithm that also computes dtdx; NULL unless fuse_nodal_gradient
+    AssembleScalarElemDiffSolverAlgorithm * fusedDiffAlg_;
     bool isInit_;
     ProjectedNodalGradientEquationSystem * projectedNodalGradEqs_;
+
+    // time step and gamma1 of the last assembled LHS
+    double lhsTimeStep_;
+    double lhsGamma1_;
+    bool constantLhsReported_;
 };
 
 #endif /* HEATCONDEQUATIONSYSTEM_H */
@@ -0,0 +1,43 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef HEATCONDMATRIXFREEOPERATOR_H
+#define HEATCONDMATRIXFREEOPERATOR_H
+
+#include <MatrixFreeOperator.h>
+#include <FieldTypeDef.h>
+
+class Realm;
+
+/** Matrix-free operator of the heat conduction equation
+ *
+ * Applies the off-diagonal part of the CVFEM diffusion stencil
+ * element-by-element, with the same integration point flux as
+ * AssembleScalarElemDiffSolverAlgorithm and ScalarDiffElemKernel.
+ * The diagonal (diffusion, mass and boundary terms) is taken from the
+ * assembled diagonal of the linear system. The scs geometry is read from
+ * the element geometry cache when it is active.
+ */
+class HeatCondMatrixFreeOperator : public MatrixFreeOperator {
+public:
+    HeatCondMatrixFreeOperator(Realm & realm,
+                               const TpetraLinearSystem & linsys,
+                               ScalarFieldType * thermalCond,
+                               const bool shiftedGradOp);
+    virtual ~HeatCondMatrixFreeOperator() {}
+
+protected:
+    void apply_off_diagonal(const host_view_type & xCol,
+                            const host_view_type & yOwned,
+                            const host_view_type & ySharedNotOwned,
+                            const size_t vec) const override;
+
+private:
+    Realm & realm_;
+    ScalarFieldType * thermalCond_;
+    VectorFieldType * coordinates_;
+    const bool shiftedGradOp_;
+};
+
+#endif /* HEATCONDMATRIXFREEOPERATOR_H */
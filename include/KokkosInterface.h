@@ -20,6 +20,7 @@
 #endif
 
 using HostSpace = Kokkos::HostSpace;
+using HostExecSpace = Kokkos::DefaultHostExecutionSpace;
 using DeviceSpace = Kokkos::DefaultExecutionSpace;
 
 using DeviceShmem = DeviceSpace::scratch_memory_space;
@@ -60,13 +61,20 @@ template<typename T> SharedMemView<T***> get_shmem_view_3D(const TeamHandleType&
     return Kokkos::subview(SharedMemView<T****>(team.team_shmem(), team.team_size(), len1, len2, len3), team.team_rank(), Kokkos::ALL(), Kokkos::ALL(), Kokkos::ALL());
 }
 
+/** Host range loop over [0,n)
+ *
+ * Runs on the default host execution space, i.e. threaded when Kokkos is built
+ * with OpenMP or Threads. The loop body must not write to shared locations
+ * without atomics (see Kokkos::atomic_add).
+ */
 template<typename SizeType, class Function> void kokkos_parallel_for(const std::string& debuggingName, SizeType n, Function loop_body) {
-    Kokkos::parallel_for(debuggingName, Kokkos::RangePolicy<Kokkos::Serial>(0, n), loop_body);
+    Kokkos::parallel_for(debuggingName, Kokkos::RangePolicy<HostExecSpace>(0, n), loop_body);
 }
 
+/** Host range reduction over [0,n) on the default host execution space*/
 template<typename SizeType, class Function, typename ReduceType>
 void kokkos_parallel_reduce(SizeType n, Function loop_body, ReduceType& reduce, const std::string& debuggingName) {
-    Kokkos::parallel_reduce(debuggingName, Kokkos::RangePolicy<Kokkos::Serial>(0, n), loop_body, reduce);
+    Kokkos::parallel_reduce(debuggingName, Kokkos::RangePolicy<HostExecSpace>(0, n), loop_body, reduce);
 }
 
 #endif /* KOKKOSINTERFACE_H */
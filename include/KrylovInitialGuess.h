@@ -0,0 +1,70 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef KRYLOVINITIALGUESS_H
+#define KRYLOVINITIALGUESS_H
+
+#include <LinearSolverTypes.h>
+
+#include <Teuchos_RCP.hpp>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+/** Initial guess of a Krylov solve from the solutions of earlier solves
+ *
+ * The solutions are kept per slot; TpetraLinearSystem uses the index of
+ * the solve within the time step, so the k-th solve of a step is predicted
+ * from the k-th solves of the previous steps. Types:
+ *  - "zero": no guess (the default)
+ *  - "previous": the last solution
+ *  - "extrapolation": polynomial extrapolation through the last m solutions
+ *  - "projection": the combination of the last m solutions with the
+ *    smallest residual |b - A x0|; A times the solutions is orthonormalized
+ *    by modified Gram-Schmidt (m operator applications per solve)
+ *
+ * Activated by the linear solver options initial_guess and initial_guess_history.
+ */
+class KrylovInitialGuess {
+public:
+    KrylovInitialGuess(const std::string & type, const int historySize);
+    ~KrylovInitialGuess() {}
+
+    /** Is a non-zero guess computed at all*/
+    bool active() const { return type_ != ZERO; }
+
+    /** Writes the guess for A x = b into x; zero without history for slot*/
+    void compute(const LinSys::Operator & A, const LinSys::Vector & b, LinSys::Vector & x, const size_t slot);
+
+    /** Keeps the converged solution x of slot; the oldest one is dropped beyond historySize*/
+    void store(const LinSys::Vector & x, const size_t slot);
+
+    /** Drops all solutions, e.g. when the maps of the linear system change*/
+    void clear();
+
+    /** |b - A x0|/|b| of the last compute(); 1 for a zero guess*/
+    double residual_ratio() const { return residualRatio_; }
+
+private:
+    enum GuessType { ZERO, PREVIOUS, EXTRAPOLATION, PROJECTION };
+
+    /** Minimal residual combination of the solutions in history into x*/
+    void project(const LinSys::Operator & A, const LinSys::Vector & b, LinSys::Vector & x,
+                 const std::deque<Teuchos::RCP<LinSys::Vector> > & history);
+
+    GuessType type_;
+    size_t historySize_;
+    double residualRatio_;
+
+    // newest solution first
+    std::vector<std::deque<Teuchos::RCP<LinSys::Vector> > > history_;
+
+    // projection work vectors; images_[i] = A basis_[i], the images orthonormal
+    std::vector<Teuchos::RCP<LinSys::Vector> > basis_;
+    std::vector<Teuchos::RCP<LinSys::Vector> > images_;
+    Teuchos::RCP<LinSys::Vector> residual_;
+};
+
+#endif /* KRYLOVINITIALGUESS_H */
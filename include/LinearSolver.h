@@ -55,6 +55,7 @@ protected:
     bool recomputePreconditioner_;
     bool reusePreconditioner_;
     double timerPrecond_;
+    bool precondComputed_;
 
 public:
     //! Flag indicating whether the preconditioner is recomputed on each invocation
@@ -69,6 +70,9 @@ public:
     //! Get the preconditioner timer for the last invocation
     double get_timer_precond();
 
+    //! Was the numeric preconditioner setup done in the last invocation
+    bool get_precond_computed();
+
     //! Get the solver configuration specified in the input file
     LinearSolverConfig* getConfig();
 };
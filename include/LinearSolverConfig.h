@@ -43,10 +43,23 @@ public:
         return reusePreconditioner_; 
     }
 
+    inline int recomputePreconditionerFrequency() const { 
+        return recomputePreconditionerFrequency_; 
+    }
+
+    inline int recomputePreconditionerIterations() const { 
+        return recomputePreconditionerIterations_; 
+    }
+
     std::string get_method() const {
         return method_;
     }
 
+    /** Name of the method for the Belos solver factory, e.g. "PSEUDOBLOCK CG" for cg*/
+    std::string belos_method() const {
+        return belosMethod_;
+    }
+
     std::string preconditioner_type() const { 
         return preconditionerType_;
     }
@@ -62,11 +75,44 @@ public:
     std::string solver_type() const { 
         return solverType_; 
     }
+
+    inline bool matrixFree() const { 
+        return matrixFree_; 
+    }
+
+    inline int chebyshevDegree() const { 
+        return chebyshevDegree_; 
+    }
+
+    inline bool useMueLu() const { 
+        return useMueLu_; 
+    }
+
+    std::string muelu_xml_file() const { 
+        return muelu_xml_file_; 
+    }
+
+    inline bool blockCrs() const { 
+        return blockCrs_; 
+    }
+
+    inline bool symmetricDirichlet() const { 
+        return symmetricDirichlet_; 
+    }
+
+    std::string initial_guess() const { 
+        return initialGuess_; 
+    }
+
+    inline int initialGuessHistory() const { 
+        return initialGuessHistory_; 
+    }
     
 protected:
     std::string solverType_;
     std::string name_;
     std::string method_;
+    std::string belosMethod_;
     std::string precond_;
     std::string preconditionerType_{"RELAXATION"};
     double tolerance_;
@@ -78,7 +124,17 @@ protected:
 
     bool recomputePreconditioner_{true};
     bool reusePreconditioner_{false};
+    int recomputePreconditionerFrequency_{1};
+    int recomputePreconditionerIterations_{0};
     bool writeMatrixFiles_{false};
+    bool matrixFree_{false};
+    int chebyshevDegree_{3};
+    bool useMueLu_{false};
+    std::string muelu_xml_file_{"milestone.xml"};
+    bool blockCrs_{true};
+    bool symmetricDirichlet_{false};
+    std::string initialGuess_{"zero"};
+    int initialGuessHistory_{2};
 };
 
 #endif /* LINEARSOLVERCONFIG_H */
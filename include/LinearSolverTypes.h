@@ -10,6 +10,7 @@
 #include <Tpetra_CrsMatrix.hpp>
 #include <Tpetra_Vector.hpp>
 #include <Tpetra_MultiVector.hpp>
+#include <Tpetra_Experimental_BlockCrsMatrix.hpp>
 
 // Forward declare templates
 namespace Teuchos {
@@ -44,6 +45,11 @@ namespace Ifpack2 {
     class Preconditioner;
 }
 
+namespace MueLu {
+    template <typename Scalar, typename LocalOrdinal, typename GlobalOrdinal, typename Node>
+    class TpetraOperator;
+}
+
 class TpetraLinearSolver;
 
 struct LinSys {
@@ -64,6 +70,8 @@ struct LinSys {
     typedef Teuchos::ArrayRCP<const Scalar >                                   ConstOneDVector;
     typedef Tpetra::Vector<Scalar,LocalOrdinal,GlobalOrdinal,Node>             Vector;
     typedef Tpetra::CrsMatrix<Scalar, LocalOrdinal, GlobalOrdinal, Node>       Matrix;
+    typedef Tpetra::Experimental::BlockCrsMatrix<Scalar, LocalOrdinal, GlobalOrdinal, Node> BlockMatrix;
+    typedef Tpetra::RowMatrix<Scalar, LocalOrdinal, GlobalOrdinal, Node>       RowMatrix;
     typedef Tpetra::Operator<Scalar, LocalOrdinal, GlobalOrdinal, Node>        Operator;
     typedef Belos::MultiVecTraits<Scalar, MultiVector>                         MultiVectorTraits;
     typedef Belos::OperatorTraits<Scalar,MultiVector, Operator>                OperatorTraits;
@@ -71,6 +79,7 @@ struct LinSys {
     typedef Belos::SolverManager<Scalar, MultiVector, Operator>                SolverManager;
     typedef Belos::TpetraSolverFactory<Scalar, MultiVector, Operator>          SolverFactory;
     typedef Ifpack2::Preconditioner<Scalar, LocalOrdinal, GlobalOrdinal, Node> Preconditioner;
+    typedef MueLu::TpetraOperator<Scalar, LocalOrdinal, GlobalOrdinal, Node>   MueLuPreconditioner;
 };
 
 #endif /* LINEARSOLVERTYPES_H */
@@ -88,6 +88,13 @@ public:
     // Matrix Assembly
     virtual void zeroSystem() = 0;
 
+    /** Keep the LHS of the last loadComplete for the next assembly
+     *
+     *  Called before zeroSystem. When lhsUnchanged is true and a full LHS has
+     *  been assembled before, the next assembly only builds the RHS.
+     */
+    virtual void reuse_lhs(const bool /*lhsUnchanged*/) {}
+
     virtual void sumInto(unsigned numEntities,
                         const stk::mesh::Entity* entities,
                         const SharedMemView<const double*> & rhs,
@@ -105,6 +112,45 @@ public:
                         const char *trace_tag=0
                         ) = 0;
 
+    /** sumInto of the lhs and rhs of the element elem; entities are the nodes of elem
+     *
+     *  A linear system may look up a precomputed scatter plan of the element.
+     */
+    virtual void sumInto(stk::mesh::Entity /*elem*/,
+                        unsigned numEntities,
+                        const stk::mesh::Entity* entities,
+                        const SharedMemView<const double*> & rhs,
+                        const SharedMemView<const double**> & lhs,
+                        const SharedMemView<int*> & localIds,
+                        const SharedMemView<int*> & sortPermutation,
+                        const char * trace_tag
+                        )
+    {
+        sumInto(numEntities, entities, rhs, lhs, localIds, sortPermutation, trace_tag);
+    }
+
+    virtual void sumInto(stk::mesh::Entity /*elem*/,
+                        const std::vector<stk::mesh::Entity> & sym_meshobj,
+                        std::vector<int> &scratchIds,
+                        std::vector<double> &scratchVals,
+                        const std::vector<double> & rhs,
+                        const std::vector<double> & lhs,
+                        const char *trace_tag=0
+                        )
+    {
+        sumInto(sym_meshobj, scratchIds, scratchVals, rhs, lhs, trace_tag);
+    }
+
+    /** Adds lhs[i] to the diagonal and rhs[i] to the rhs of the row of entities[i]
+     *
+     *  Nodal terms of a single dof equation (e.g. the lumped mass) without the
+     *  sorting and column search of the generic sumInto.
+     */
+    virtual void sumIntoDiagonal(const unsigned numEntities,
+                                 const stk::mesh::Entity * entities,
+                                 const double * lhs,
+                                 const double * rhs);
+
     virtual void applyDirichletBCs(stk::mesh::FieldBase * solutionField,
                                     stk::mesh::FieldBase * bcValuesField,
                                     const stk::mesh::PartVector & parts,
@@ -127,11 +173,19 @@ public:
     virtual int solve(stk::mesh::FieldBase * linearSolutionField) = 0;
     virtual void loadComplete() = 0;
 
+    /** Starts sending the sharedNotOwned rows to their owners; loadComplete waits for them
+     *
+     *  Only the owned rows may be assembled in between.
+     */
+    virtual void beginLoadComplete() {}
+
     virtual void writeToFile(const char * filename, bool useOwned=true) = 0;
     virtual void writeSolutionToFile(const char * filename, bool useOwned=true) = 0;
     unsigned numDof() const { return numDof_; }
     const int & linearSolveIterations() {return linearSolveIterations_; }
     const double & linearResidual() {return linearResidual_; }
+    bool initialGuessActive() const {return initialGuessActive_; }
+    const double & initialGuessResidual() {return initialGuessResidual_; }
     const double & nonLinearResidual() {return nonLinearResidual_; }
     const double & scaledNonLinearResidual() {return scaledNonLinearResidual_; }
     void setNonLinearResidual(const double nlr) { nonLinearResidual_ = nlr; }
@@ -139,8 +193,23 @@ public:
     bool & recomputePreconditioner() {return recomputePreconditioner_; }
     bool & reusePreconditioner() {return reusePreconditioner_; }
     double get_timer_precond();
+    bool get_precond_computed();
     void zero_timer_precond();
 
+    /** Colour of each locally owned element, indexed by the element's local offset
+     *
+     *  Elements of the same colour share no node. The vector is empty (and
+     *  num_element_colors() is 0) unless use_element_coloring is requested.
+     */
+    const std::vector<int> & element_colors() const { return elemColor_; }
+    int num_element_colors() const { return numElemColors_; }
+
+    /** Let sumInto skip atomics; only valid while elements of one colour are assembled*/
+    void set_atomic_free_assembly(bool atomicFree) { atomicFreeAssembly_ = atomicFree; }
+
+    /** The mesh was not modified since finalizeLinearSystem; the graph and maps are still valid*/
+    bool mesh_unchanged() const;
+
 protected:
     virtual void beginLinearSystemConstruction() = 0;
     virtual void checkError(const int err_code, const char * msg) = 0;
@@ -148,6 +217,9 @@ protected:
     void sync_field(const stk::mesh::FieldBase *field);
     bool debug();
 
+    /** Records the mesh state the graph is built for; called by finalizeLinearSystem*/
+    void record_mesh_state();
+
     Realm & realm_;
     EquationSystem * eqSys_;
     bool inConstruction_;
@@ -159,10 +231,16 @@ protected:
     int linearSolveIterations_;
     double nonLinearResidual_;
     double linearResidual_;
+    bool initialGuessActive_;
+    double initialGuessResidual_;
     double firstNonLinearResidual_;
     double scaledNonLinearResidual_;
     bool recomputePreconditioner_;
     bool reusePreconditioner_;                                    
+    std::vector<int> elemColor_;
+    int numElemColors_;
+    bool atomicFreeAssembly_;
+    size_t meshModificationCount_;
 
 public:
     bool provideOutput_;
@@ -0,0 +1,106 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef MATRIXFREEOPERATOR_H
+#define MATRIXFREEOPERATOR_H
+
+#include <LinearSolverTypes.h>
+#include <TpetraLinearSystem.h>
+
+#include <Teuchos_RCP.hpp>
+#include <Tpetra_Operator.hpp>
+
+#include <string>
+
+/** Base class of an operator that is applied without an assembled CrsMatrix
+ *
+ * The linear system still assembles the RHS and the diagonal of the LHS
+ * through sumInto. The off-diagonal part is applied element-by-element by
+ * the derived class in apply_off_diagonal; the result is exported from the
+ * sharedNotOwned to the owned rows exactly as the assembled matrix would be.
+ * Rows touched by applyDirichletBCs or resetRows keep only their diagonal.
+ */
+class MatrixFreeOperator : public LinSys::Operator {
+public:
+    MatrixFreeOperator(const TpetraLinearSystem & linsys);
+    virtual ~MatrixFreeOperator() {}
+
+    Teuchos::RCP<const LinSys::Map> getDomainMap() const override;
+    Teuchos::RCP<const LinSys::Map> getRangeMap() const override;
+
+    /** Y = alpha*A*X + beta*Y; only NO_TRANS is supported*/
+    void apply(const LinSys::MultiVector & X,
+               LinSys::MultiVector & Y,
+               Teuchos::ETransp mode = Teuchos::NO_TRANS,
+               LinSys::Scalar alpha = Teuchos::ScalarTraits<LinSys::Scalar>::one(),
+               LinSys::Scalar beta = Teuchos::ScalarTraits<LinSys::Scalar>::zero()) const override;
+
+protected:
+    /** Add the off-diagonal contributions A_ij x_j (i != j) of column vec of xCol
+     *
+     *  @param[in] xCol X imported to the column map, indexed by the column LIDs
+     *  @param[out] yOwned Contributions to the owned rows, indexed by the row LIDs
+     *  @param[out] ySharedNotOwned Contributions to the sharedNotOwned rows, row LID - max_owned_row_id()
+     *  @param[in] vec Column of the multivectors to work on
+     */
+    virtual void apply_off_diagonal(const host_view_type & xCol,
+                                    const host_view_type & yOwned,
+                                    const host_view_type & ySharedNotOwned,
+                                    const size_t vec) const = 0;
+
+    /** Adds value to row rowLid of yOwned or ySharedNotOwned; ghosted rows are skipped like in sumInto*/
+    void add_to_row(const LinSys::LocalOrdinal rowLid, const double value,
+                    const host_view_type & yOwned,
+                    const host_view_type & ySharedNotOwned,
+                    const size_t vec) const;
+
+    const TpetraLinearSystem & linsys_;
+
+private:
+    void allocate_work_vectors(const size_t numVecs) const;
+
+    mutable Teuchos::RCP<LinSys::MultiVector> xCol_;
+    mutable Teuchos::RCP<LinSys::MultiVector> yOwned_;
+    mutable Teuchos::RCP<LinSys::MultiVector> ySharedNotOwned_;
+};
+
+/** Diagonal based preconditioner for a MatrixFreeOperator
+ *
+ * "jacobi" applies the inverse of the assembled diagonal, "chebyshev" a
+ * Chebyshev polynomial in D^-1 A whose largest eigenvalue is estimated by
+ * a few power iterations in compute().
+ */
+class MatrixFreePreconditioner : public LinSys::Operator {
+public:
+    MatrixFreePreconditioner(Teuchos::RCP<const LinSys::Operator> A,
+                             Teuchos::RCP<const LinSys::Vector> diagonal,
+                             const std::string & type,
+                             const int degree);
+    virtual ~MatrixFreePreconditioner() {}
+
+    /** Invert the current diagonal (and estimate lambda_max for chebyshev); call after each assembly*/
+    void compute();
+
+    Teuchos::RCP<const LinSys::Map> getDomainMap() const override { return A_->getDomainMap(); }
+    Teuchos::RCP<const LinSys::Map> getRangeMap() const override { return A_->getRangeMap(); }
+
+    void apply(const LinSys::MultiVector & X,
+               LinSys::MultiVector & Y,
+               Teuchos::ETransp mode = Teuchos::NO_TRANS,
+               LinSys::Scalar alpha = Teuchos::ScalarTraits<LinSys::Scalar>::one(),
+               LinSys::Scalar beta = Teuchos::ScalarTraits<LinSys::Scalar>::zero()) const override;
+
+private:
+    double estimate_lambda_max() const;
+
+    Teuchos::RCP<const LinSys::Operator> A_;
+    Teuchos::RCP<const LinSys::Vector> diagonal_;
+    Teuchos::RCP<LinSys::Vector> invDiagonal_;
+    const bool useChebyshev_;
+    const int degree_;
+    double lambdaMax_;
+    double lambdaMin_;
+};
+
+#endif /* MATRIXFREEOPERATOR_H */
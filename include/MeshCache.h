@@ -0,0 +1,138 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+#include <stk_util/parallel/Parallel.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace stk { namespace io { class StkMeshIoBroker; } }
+
+/** Binary cache of the preprocessed mesh for repeated runs on the same mesh
+ *
+ * Files are keyed on a hash of the input mesh file(s), the number of ranks
+ * and the decomposition method, so a changed mesh or rank count never hits a
+ * stale entry. Two kinds of entries are kept in the directory given by the
+ * realm option mesh_cache:
+ *
+ *  - the mesh decomposed by automatic_decomposition_type, as one Exodus file
+ *    per rank; a warm run reads it instead of decomposing the serial file
+ *  - per rank and equation system, the finalized row/column maps and CRS
+ *    graphs of TpetraLinearSystem (see MeshCacheReader)
+ *
+ * Entries are written by the first (cold) run and only read afterwards.
+ */
+class MeshCache {
+public:
+    MeshCache(stk::ParallelMachine comm, const std::string & directory,
+              const std::string & inputDBName, const std::string & decompType);
+    ~MeshCache();
+
+    /** Per rank Exodus files of the decomposed mesh, complete on all ranks*/
+    bool has_mesh() const { return hasMesh_; }
+    /** Base name of the decomposed mesh; Ioss appends the rank*/
+    std::string mesh_file() const;
+    /** Collective; writes the decomposed mesh of ioBroker and marks it complete*/
+    void store_mesh(stk::io::StkMeshIoBroker & ioBroker);
+
+    /** File of this rank for the entry name, e.g. a linear system*/
+    std::string rank_file(const std::string & name) const;
+
+    /** Hit statistics of the rank files; reported at the end of Realm::initialize*/
+    void count_lookup(const bool hit) { hit ? ++numHits_ : ++numMisses_; }
+    int num_hits() const { return numHits_; }
+    int num_misses() const { return numMisses_; }
+
+    /** FNV-1a hash of the bytes of fileName, folded into hash*/
+    static uint64_t hash_file(const std::string & fileName, uint64_t hash);
+    /** FNV-1a hash of the bytes of data, folded into hash*/
+    static uint64_t hash_bytes(const void * data, const size_t numBytes, uint64_t hash);
+
+private:
+    std::string prefix() const;
+
+    stk::ParallelMachine comm_;
+    const std::string directory_;
+    const bool decomposed_;
+    uint64_t key_;
+    bool hasMesh_;
+    int numHits_;
+    int numMisses_;
+};
+
+/** Read-only memory map of a cache file written by MeshCacheWriter
+ *
+ * The sections are read back in the order they were written; every read
+ * checks the remaining size, so a truncated file is rejected, not crashed on.
+ */
+class MeshCacheReader {
+public:
+    explicit MeshCacheReader(const std::string & fileName);
+    ~MeshCacheReader();
+
+    /** The file exists, is mapped and starts with the expected header*/
+    bool valid() const { return NULL != data_; }
+
+    template<typename T>
+    bool read(std::vector<T> & values) {
+        uint64_t count = 0;
+        if ( !read_raw(&count, sizeof(count)) || count > (size_ - pos_)/sizeof(T) )
+            return false;
+        values.resize(count);
+        return read_raw(values.data(), count*sizeof(T));
+    }
+
+    template<typename T>
+    bool read(T & value) { return read_raw(&value, sizeof(T)); }
+
+    bool read(std::string & value);
+
+private:
+    bool read_raw(void * dest, const size_t numBytes);
+
+    const char * data_;
+    size_t size_;
+    size_t pos_;
+};
+
+/** Sequential writer of a cache file
+ *
+ * Writes to a temporary file that close() renames, so a reader never sees
+ * a partial entry.
+ */
+class MeshCacheWriter {
+public:
+    explicit MeshCacheWriter(const std::string & fileName);
+    ~MeshCacheWriter();
+
+    template<typename T>
+    void write(const std::vector<T> & values) {
+        const uint64_t count = values.size();
+        write_raw(&count, sizeof(count));
+        write_raw(values.data(), count*sizeof(T));
+    }
+
+    template<typename T>
+    void write(const T & value) { write_raw(&value, sizeof(T)); }
+
+    void write(const std::string & value);
+
+    /** Returns false if any write failed; the entry is then discarded*/
+    bool close();
+
+private:
+    void write_raw(const void * src, const size_t numBytes);
+
+    const std::string fileName_;
+    const std::string tmpName_;
+    std::ofstream stream_;
+};
+
+#endif /* MESHCACHE_H */
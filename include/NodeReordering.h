@@ -0,0 +1,66 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef NODEREORDERING_H
+#define NODEREORDERING_H
+
+#include <stk_mesh/base/Entity.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+class Realm;
+
+/** Local renumbering of the owned rows of a linear system
+ *
+ * TpetraLinearSystem numbers its owned rows (and therefore the leading
+ * columns) in the order of the owned node list, which is sorted by global
+ * id and thus depends on the mesh generator. This class reorders that list
+ * by reverse Cuthill-McKee on the node-to-node graph of the elements
+ * ("rcm") or along a Hilbert curve through the node coordinates
+ * ("hilbert"). Only the local ids change; the global ids, the maps'
+ * ownership and the output are not affected.
+ *
+ * Activated by the solution option node_reordering.
+ */
+class NodeReordering {
+public:
+    NodeReordering(Realm & realm, const std::string & type);
+    ~NodeReordering();
+
+    /** Reorders nodes in place; nodes holds the owned nodes of this process*/
+    void apply(std::vector<stk::mesh::Entity> & nodes);
+
+    /** Largest |i-j| over the connected owned rows i and j, before and after apply()*/
+    size_t bandwidthBefore_;
+    size_t bandwidthAfter_;
+
+private:
+    /** Node-to-node adjacency of nodes through their elements, in CRS form*/
+    void build_adjacency(const std::vector<stk::mesh::Entity> & nodes);
+
+    /** newToOld permutation by reverse Cuthill-McKee*/
+    void rcm_order(std::vector<size_t> & newToOld) const;
+
+    /** newToOld permutation along a Hilbert curve*/
+    void hilbert_order(const std::vector<stk::mesh::Entity> & nodes, std::vector<size_t> & newToOld) const;
+
+    /** Breadth first level sets from root; returns the depth and the nodes of the last level*/
+    size_t level_structure(const size_t root, std::vector<int> & level, std::vector<size_t> & lastLevel) const;
+
+    /** Bandwidth for a node ordering given as position of each node*/
+    size_t bandwidth(const std::vector<size_t> & position) const;
+
+    /** Hilbert index of a point given in integer coordinates of bits bits each*/
+    static uint64_t hilbert_key(unsigned * X, const int nDim, const int bits);
+
+    Realm & realm_;
+    const std::string type_;
+
+    std::vector<size_t> adjOffsets_;
+    std::vector<size_t> adjNodes_;
+};
+
+#endif /* NODEREORDERING_H */
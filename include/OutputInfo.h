@@ -47,6 +47,7 @@ public:
     int outputFreq_;
     int outputStart_;
     bool outputNodeSet_; 
+    bool outputAsync_;
     int serializedIOGroupSize_;
     bool hasOutputBlock_;
     bool hasRestartBlock_;
@@ -58,6 +59,7 @@ public:
     int restartStart_;
     int restartMaxDataBaseStepSize_;
     bool restartNodeSet_;
+    bool restartAsync_;
     int outputCompressionLevel_;
     bool outputCompressionShuffle_;
     int restartCompressionLevel_;
@@ -36,6 +36,7 @@ public:
     void register_nodal_fields(stk::mesh::Part *part);
     void register_wall_bc(stk::mesh::Part *part, const stk::topology &theTopo, const WallBoundaryConditionData & wallBCData);
     void initialize();
+    void reinitialize_linear_system();
     
     // internal solve and update from EquationSystems
     void solve_and_update();
@@ -36,6 +36,9 @@ class TimeIntegrator;
 class MasterElement;
 class LagrangeBasis;
 class ComputeGeometryAlgorithmDriver;
+class ElemGeometryCache;
+class AsyncOutputWriter;
+class MeshCache;
 
 
 //! Stores information and methods for a specific computational domain
@@ -73,6 +76,9 @@ public:
     void create_mesh();
     void setup_nodal_fields();
     void setup_edge_fields();
+    void create_edges();
+    /** Moves the locally owned elements with a shared or boundary condition node into sharedElementPart_*/
+    void mark_shared_elements();
     void setup_element_fields();
     void setup_interior_algorithms();
     void setup_bc();
@@ -82,6 +88,16 @@ public:
     void output_converged_results();
     void commit();
     void create_output_mesh();
+    /** Declares the snapshot of each output variable for the asynchronous results output*/
+    void setup_output_fields();
+    /** Declares the snapshot of each state of the restart variables; before populate_mesh*/
+    void setup_restart_fields();
+    /** Defines the restart database; the writer thread only adds steps*/
+    void create_restart_mesh();
+    /** Restart step at restart_frequency; written from the snapshots, by default on the writer thread*/
+    void provide_restart_output();
+    /** Copies the restart variables into their snapshots or, with toSnapshot false, back*/
+    void copy_restart_fields(bool toSnapshot);
     void input_variables_from_mesh();
     void augment_output_variable_list(const std::string fieldName);
     void augment_restart_variable_list(std::string restartFieldName);
@@ -91,6 +107,14 @@ public:
     void provide_output();
     void set_global_id();
     void check_job(bool get_node_count);
+    /** Load imbalance and cut of the decomposition; part of the check_job review after the mesh is populated*/
+    void check_decomposition();
+    /** Rebalances the mesh when the measured assembly and solve cost is imbalanced; see balance_nodes*/
+    void balance_nodes();
+    /** Moves the elements to balance the weights of compute_balance_weights; rebuilds what depends on the decomposition*/
+    void rebalance_mesh(const double assembleTime, const double solveTime);
+    /** Element weights of the measured cost: assembly per element node plus the solve cost of the owned rows*/
+    void compute_balance_weights(const double assembleTime, const double solveTime);
     void dump_simulation_time();
     double provide_mean_norm();
     void provide_entity_count();
@@ -101,6 +125,8 @@ public:
     virtual void populate_boundary_data();
     virtual void boundary_data_to_state_data();
     virtual double populate_variables_from_input(const double currentTime);
+    /** Reads all states of the restart variables at restart_time from the input mesh; returns the time found*/
+    virtual double populate_restart(double & timeStepNm1, int & timeStepCount);
     virtual void populate_external_variables_from_input(const double currentTime) {}
     virtual void populate_derived_quantities();
     virtual void evaluate_properties();
@@ -157,6 +183,9 @@ public:
     // inactive part
     stk::mesh::Selector get_inactive_selector();
     
+    /** Entities of an assembly region; the universal part without overlap_shared_export*/
+    stk::mesh::Selector assembly_region_selector(AssemblyRegion region);
+    
     // mesh parts for all interior domains
     stk::mesh::PartVector interiorPartVec_;
     
@@ -201,6 +230,9 @@ public:
     std::string inputDBName_;
     unsigned spatialDimension_;
     int solveFrequency_;
+    
+    // edge-based assembly; edges are created after populate_mesh
+    bool realmUsesEdges_;
     stk::mesh::MetaData *metaData_;
     stk::mesh::BulkData *bulkData_;
     stk::io::StkMeshIoBroker *ioBroker_;
@@ -211,12 +243,18 @@ public:
     // part for all exposed surfaces in the mesh
     stk::mesh::Part *exposedBoundaryPart_;
     
+    // elements with a shared or bc node (and their edges); NULL unless overlap_shared_export
+    stk::mesh::Part *sharedElementPart_;
+    
     // hoflow field data
     GlobalIdFieldType *hoflowGlobalId_;
     
     // algorithm drivers managed by region
     ComputeGeometryAlgorithmDriver *computeGeometryAlgDriver_;
     
+    // opt-in element geometry cache; NULL unless use_element_geometry_cache
+    ElemGeometryCache *elemGeometryCache_;
+    
     BoundaryConditions boundaryConditions_;
     InitialConditions initialConditions_;
     MaterialProperties materialProperties_;
@@ -236,6 +274,31 @@ public:
     
     // allow aura to be optional
     bool activateAura_;
+
+    // Ioss decomposition of a serial mesh at load (rcb, rib, hsfc, kway, ...); None reads a decomposed mesh
+    std::string autoDecompType_;
+
+    // cache of the decomposed mesh and the linear system graphs; NULL unless mesh_cache
+    std::string meshCacheDir_;
+    MeshCache *meshCache_;
+    bool use_cached_mesh() const;
+    // create_mesh read the decomposed mesh from the cache
+    bool meshFromCache_;
+
+    // runtime rebalancing by the measured cost
+    struct BalanceNodeOptions {
+        BalanceNodeOptions() : target(1.5), numIters(5), frequency(10) {};
+        double target;   // rebalance when the max/avg cost of the ranks exceeds it
+        int numIters;    // max number of rebalances
+        int frequency;   // time steps between the checks
+    };
+    bool doBalanceNodes_;
+    BalanceNodeOptions balanceNodeOptions_;
+    ScalarFieldType *balanceWeight_;
+    double balanceAssembleTime_;
+    double balanceSolveTime_;
+    int numRebalances_;
+    double timerRebalance_;
     
     size_t inputMeshIdx_;
     const YAML::Node & node_;
@@ -259,6 +322,30 @@ public:
     
     std::string simType_;
     int outputCounter_;
+
+    // output variables and their snapshot; empty for synchronous results output
+    std::vector<std::pair<stk::mesh::FieldBase *, stk::mesh::FieldBase *> > outputFields_;
+    // steps written to the current results file; the first defines the transient fields
+    int outputStepsInFile_;
+    int numOutputSteps_;
+
+    // restart variables by state, their snapshot and the name on the restart database
+    struct RestartField {
+        stk::mesh::FieldBase *stateField_;
+        stk::mesh::FieldBase *snapshotField_;
+        std::string dbName_;
+    };
+    std::vector<RestartField> restartFields_;
+    size_t restartFileIndex_;
+    // steps written to the current restart file; the first step of a file
+    // (and of each overwrite cycle) defines the transient fields
+    int restartStepsInFile_;
+
+    // writer thread of the restart steps; NULL for synchronous output
+    AsyncOutputWriter *outputWriter_;
+    int numRestartSteps_;
+    double timerRestartStall_;
+    double maxRestartStall_;
 };
 
 #endif /* REALM_H */
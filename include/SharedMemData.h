@@ -33,6 +33,7 @@ struct SharedMemData {
         sortPermutation = get_int_shmem_view_1D(team, rhsSize);
     }
 
+    stk::mesh::Entity elems[simdLen];
     const stk::mesh::Entity* elemNodes[simdLen];
     int numSimdElems;
     std::unique_ptr<ScratchViews<double>> prereqData[simdLen];
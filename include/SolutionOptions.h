@@ -121,6 +121,15 @@ public:
     bool consistentMMPngDefault_;
     bool useConsolidatedSolverAlg_;
     bool useConsolidatedBcSolverAlg_;
+    bool useElementColoring_;
+    bool useElemGeometryCache_;
+    bool reuseConstantLhs_;
+    bool useScatterPlan_;
+    bool useEdges_;
+    bool fuseNodalGradient_;
+    bool staticGraphAssembly_;
+    bool overlapSharedExport_;
+    std::string nodeReordering_;
     bool eigenvaluePerturb_;
     double eigenvaluePerturbDelta_;
     int eigenvaluePerturbBiasTowards_;
@@ -6,6 +6,7 @@
 #define SOLVERALGORITHM_H
 
 #include <Algorithm.h>
+#include <Enums.h>
 #include <KokkosInterface.h>
 
 #include <stk_mesh/base/Entity.hpp>
@@ -27,6 +28,14 @@ public:
   virtual void execute() = 0;
   virtual void initialize_connectivity() = 0;
 
+  /** True if execute() restricts its entities to region_
+   *
+   *  Only algorithms whose contributions are plain sums may be split;
+   *  see SolverAlgorithmDriver::execute_overlapped.
+   */
+  virtual bool assembles_by_region() const { return false; }
+  void set_assembly_region(AssemblyRegion region) { region_ = region; }
+
 protected:
 
   // Need to find out whether this ever gets called inside a modification cycle.
@@ -47,7 +56,28 @@ protected:
     const SharedMemView<const double**> & lhs,
     const char *trace_tag);
 
+  // element-keyed variants; sym_meshobj must be the nodes of elem in connectivity order
+  void apply_coeff(
+    stk::mesh::Entity elem,
+    const std::vector<stk::mesh::Entity> & sym_meshobj,
+    std::vector<int> &scratchIds,
+    std::vector<double> &scratchVals,
+    const std::vector<double> &rhs,
+    const std::vector<double> &lhs,
+    const char *trace_tag=0);
+
+  void apply_coeff(
+    stk::mesh::Entity elem,
+    unsigned numMeshobjs,
+    const stk::mesh::Entity* symMeshobjs,
+    const SharedMemView<int*> & scratchIds,
+    const SharedMemView<int*> & sortPermutation,
+    const SharedMemView<const double*> & rhs,
+    const SharedMemView<const double**> & lhs,
+    const char *trace_tag);
+
   EquationSystem *eqSystem_;
+  AssemblyRegion region_;
 };
 
 #endif /* SOLVERALGORITHM_H */
@@ -12,6 +12,7 @@
 
 class Realm;
 class SolverAlgorithm;
+class LinearSystem;
 
 /** Container class that stores solver algorithms
  * 
@@ -38,6 +39,14 @@ public:
     /** Executes all algorithms stored between pre_work() and post_work()*/
     virtual void execute();
     
+    /** execute() around linsys.beginLoadComplete()
+     *
+     *  The interior entities of the algorithms that assemble by region are
+     *  left for last; everything else, including the constraint and Dirichlet
+     *  rows, is final when the sharedNotOwned rows are sent to their owners.
+     */
+    virtual void execute_overlapped(LinearSystem & linsys);
+    
     /** Work that has to be done after the actual solver algorithm*/
     virtual void post_work();
 
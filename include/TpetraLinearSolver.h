@@ -7,6 +7,7 @@
 
 #include <LinearSolver.h>
 #include <LocalGraphArrays.h>
+#include <KrylovInitialGuess.h>
 #include <Enums.h>
 
 #include <Kokkos_DefaultNode.hpp>
@@ -18,6 +19,7 @@
 #include <Ifpack2_Factory.hpp>
 
 class TpetraLinearSolverConfig;
+class MatrixFreePreconditioner;
 
 typedef double Scalar;
 typedef long GlobalOrdinal;
@@ -45,6 +47,26 @@ public:
                             Teuchos::RCP<LinSys::Vector> rhs,
                             Teuchos::RCP<LinSys::MultiVector> coords);
 
+    /** Creates a linear system of equations with a matrix-free operator
+     *
+     *  The preconditioner is built from the assembled diagonal (jacobi or chebyshev).
+     */
+    void setupLinearSolver(Teuchos::RCP<LinSys::Vector> sln,
+                            Teuchos::RCP<LinSys::Operator> op,
+                            Teuchos::RCP<LinSys::Vector> diagonal,
+                            Teuchos::RCP<LinSys::Vector> rhs,
+                            Teuchos::RCP<LinSys::MultiVector> coords);
+    
+    /** Creates a linear system of equations with a BlockCrsMatrix
+     *
+     *  Only the block-aware Ifpack2 preconditioners are used: relaxation
+     *  (jacobi, sgs) and RBILUK in place of riluk.
+     */
+    void setupLinearSolver(Teuchos::RCP<LinSys::Vector> sln,
+                            Teuchos::RCP<LinSys::BlockMatrix> matrix,
+                            Teuchos::RCP<LinSys::Vector> rhs,
+                            Teuchos::RCP<LinSys::MultiVector> coords);
+    
     virtual void destroyLinearSolver() override;
 
     /** Compute the norm of the non-linear solution vector
@@ -68,7 +90,43 @@ public:
 
     virtual PetraType getType() override { return PT_TPETRA; }
 
+    /** The matrix is the same as in the last solve; its preconditioner stays valid*/
+    void set_matrix_unchanged(const bool matrixUnchanged) { matrixUnchanged_ = matrixUnchanged; }
+
+    /** History slot of the initial guess for the next solve*/
+    void set_initial_guess_slot(const size_t slot) { guessSlot_ = slot; }
+
+    /** Is the solve started from a non-zero initial guess*/
+    bool initial_guess_active() const { return initialGuess_.active(); }
+
+    /** |b - A x0|/|b| of the initial guess of the last solve*/
+    double initial_guess_residual_ratio() const { return initialGuess_.residual_ratio(); }
+
+    /** Is MueLu the preconditioner; it needs the nodal coordinates*/
+    bool activeMueLu() const { return activeMueLu_; }
+
 private:
+    /** Decide whether the numeric preconditioner setup is redone for this solve
+     *
+     *  Never when the matrix is unchanged since the last solve. Without
+     *  reuse (the default) it is redone for every solve. With
+     *  reuse_preconditioner or recompute_preconditioner: no it is kept until
+     *  the last solve needed more than recompute_preconditioner_iterations;
+     *  otherwise it is redone every recompute_preconditioner_frequency solves.
+     */
+    bool need_precond_compute() const;
+
+    /** Clear the reuse state; the preconditioner is rebuilt and the initial guess history dropped*/
+    void reset_precond_state();
+
+    /** Build the MueLu hierarchy from the xml file, or refresh it for the current matrix
+     *
+     *  The hierarchy is created once per setupLinearSolver. Later calls hand the
+     *  new matrix to MueLu::ReuseTpetraPreconditioner, which keeps whatever the
+     *  "reuse: type" of the xml file allows (e.g. aggregates or the prolongator).
+     */
+    void setup_muelu();
+
     /** the solver parameters*/
     const Teuchos::RCP<Teuchos::ParameterList> params_;
 
@@ -76,13 +134,29 @@ private:
     const Teuchos::RCP<Teuchos::ParameterList> paramsPrecond_;
     
     Teuchos::RCP<LinSys::Matrix> matrix_;
+    /** The operator applied by the solver; matrix_ unless matrix-free or block*/
+    Teuchos::RCP<const LinSys::Operator> operator_;
+    Teuchos::RCP<MatrixFreePreconditioner> matrixFreePreconditioner_;
     Teuchos::RCP<LinSys::Vector> rhs_;
     Teuchos::RCP<LinSys::LinearProblem> problem_;
     Teuchos::RCP<LinSys::SolverManager> solver_;
     Teuchos::RCP<LinSys::Preconditioner> preconditioner_;
+    Teuchos::RCP<LinSys::MueLuPreconditioner> mueluPreconditioner_;
     Teuchos::RCP<LinSys::MultiVector> coords_;
 
     std::string preconditionerType_;
+    const bool activeMueLu_;
+
+    /** Symbolic setup (initialize) done; the graph is static until the next setupLinearSolver*/
+    bool precondInitialized_;
+    /** Numeric setup (compute) done at least once since the last setupLinearSolver*/
+    bool precondHasBeenComputed_;
+    int solvesSinceCompute_;
+    int lastIterations_;
+    bool matrixUnchanged_;
+
+    KrylovInitialGuess initialGuess_;
+    size_t guessSlot_;
 };
 
 #endif /* TPETRALINEARSOLVER_H */
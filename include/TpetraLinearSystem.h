@@ -19,6 +19,7 @@
 #include <stk_mesh/base/Entity.hpp>
 #include <stk_mesh/base/FieldBase.hpp>
 
+#include <map>
 #include <vector>
 #include <string>
 #include <unordered_map>
@@ -59,6 +60,7 @@ public:
 
     // Matrix Assembly
     void zeroSystem();
+    void reuse_lhs(const bool lhsUnchanged);
 
     void sumInto(unsigned numEntities,
                 const stk::mesh::Entity* entities,
@@ -76,6 +78,31 @@ public:
                 const char *trace_tag=0
                 );
 
+    /** Element sumInto through the scatter plan; falls back to the sorted sumInto without one*/
+    void sumInto(stk::mesh::Entity elem,
+                unsigned numEntities,
+                const stk::mesh::Entity* entities,
+                const SharedMemView<const double*> & rhs,
+                const SharedMemView<const double**> & lhs,
+                const SharedMemView<int*> & localIds,
+                const SharedMemView<int*> & sortPermutation,
+                const char * trace_tag);
+
+    void sumInto(stk::mesh::Entity elem,
+                const std::vector<stk::mesh::Entity> & entities,
+                std::vector<int> &scratchIds,
+                std::vector<double> &scratchVals,
+                const std::vector<double> & rhs,
+                const std::vector<double> & lhs,
+                const char *trace_tag=0
+                );
+
+    /** Diagonal sumInto through the cached diagonal value offsets of the CrsMatrix*/
+    void sumIntoDiagonal(const unsigned numEntities,
+                         const stk::mesh::Entity * entities,
+                         const double * lhs,
+                         const double * rhs);
+
     void applyDirichletBCs(stk::mesh::FieldBase * solutionField,
                         stk::mesh::FieldBase * bcValuesField,
                         const stk::mesh::PartVector & parts,
@@ -95,6 +122,8 @@ public:
     // Solve
     int solve(stk::mesh::FieldBase * linearSolutionField);
     void loadComplete();
+    /** Posts the sharedNotOwned rows to their owners through the shared row export plan*/
+    void beginLoadComplete();
     void writeToFile(const char * filename, bool useOwned=true);
     void printInfo(bool useOwned = true);
     void writeSolutionToFile(const char * filename, bool useOwned=true);
@@ -107,6 +136,20 @@ public:
 
     Teuchos::RCP<LinSys::Graph>  getOwnedGraph() { return ownedGraph_; }
     Teuchos::RCP<LinSys::Matrix> getOwnedMatrix() { return ownedMatrix_; }
+    
+    // accessors for a MatrixFreeOperator
+    bool is_matrix_free() const { return matrixFree_; }
+    bool is_block_crs() const { return blockCrs_; }
+    Teuchos::RCP<const LinSys::Map> getOwnedRowsMap() const { return ownedRowsMap_; }
+    Teuchos::RCP<const LinSys::Map> getSharedNotOwnedRowsMap() const { return sharedNotOwnedRowsMap_; }
+    Teuchos::RCP<const LinSys::Import> getColumnImporter() const { return colImporter_; }
+    Teuchos::RCP<const LinSys::Export> getExporter() const { return exporter_; }
+    Teuchos::RCP<const LinSys::Vector> getMatrixFreeDiagonal() const { return ownedDiag_; }
+    Teuchos::RCP<const LinSys::Vector> getDirichletMask() const { return dirichletMask_; }
+    LocalOrdinal entity_row_lid(stk::mesh::Entity entity) const { return entityToLID_[entity.local_offset()]; }
+    LocalOrdinal entity_col_lid(stk::mesh::Entity entity) const { return entityToColLID_[entity.local_offset()]; }
+    LocalOrdinal max_owned_row_id() const { return maxOwnedRowId_; }
+    LocalOrdinal max_shared_not_owned_row_id() const { return maxSharedNotOwnedRowId_; }
 
 private:
     void buildConnectedNodeGraph(stk::mesh::EntityRank rank,
@@ -132,9 +175,158 @@ private:
                                   LocalGraphArrays & locallyOwnedGraph,
                                   LocalGraphArrays & sharedNotOwnedGraph);
 
+    /** Sets up rhs, diagonal and the MatrixFreeOperator of the equation system instead of the CrsMatrix*/
+    void finalize_matrix_free();
+    
+    /** Derives the node maps and graphs from the point graph and sets up the BlockCrsMatrix*/
+    void finalize_block_crs(const LocalGraphArrays & ownedGraph, const LocalGraphArrays & sharedNotOwnedGraph);
+
+    /** Sets up the CrsGraph, CrsMatrix and vectors from the row lengths and local graphs*/
+    void finalize_crs(LinSys::RowLengths & locallyOwnedRowLengths,
+                      LinSys::RowLengths & sharedNotOwnedRowLengths,
+                      const LocalGraphArrays & ownedGraph,
+                      const LocalGraphArrays & sharedNotOwnedGraph);
+
+    // graph cache; the build calls are recorded and either replaced by a
+    // cache entry or replayed in finalizeLinearSystem
+    enum GraphBuildType { GB_NODE, GB_FACE_TO_NODE, GB_EDGE_TO_NODE, GB_ELEM_TO_NODE,
+                          GB_REDUCED_ELEM_TO_NODE, GB_FACE_ELEM_TO_NODE };
+
+    /** The realm has a mesh cache and the matrix is a CrsMatrix*/
+    bool use_graph_cache() const;
+
+    /** Records a build call; false if it has to run now*/
+    bool defer_graph_build(const GraphBuildType type, const stk::mesh::PartVector & parts);
+    void replay_graph_build();
+
+    /** Equation system, dofs, node reordering and the recorded build calls*/
+    std::string graph_cache_signature() const;
+
+    /** Order independent hashes of the owned node ids and of the sharedNotOwned (id, owner) pairs*/
+    void node_set_hash(uint64_t & ownedHash, uint64_t & sharedHash);
+
+    /** Collective; sets up the maps and the CrsMatrix from the cache if all ranks have a valid entry*/
+    bool load_graph_cache();
+    void store_graph_cache(const std::vector<GlobalOrdinal> & optColGids,
+                           const std::vector<int> & sourcePIDs,
+                           const Kokkos::View<size_t*,HostSpace> & ownedRowLengths,
+                           const Kokkos::View<size_t*,HostSpace> & sharedNotOwnedRowLengths,
+                           const LocalGraphArrays & ownedGraph,
+                           const LocalGraphArrays & sharedNotOwnedGraph);
+
+    /** BlockCrsMatrix sumInto; meshColIds and entityPermutation are scratch of numEntities*/
+    void sum_into_block(const unsigned numEntities,
+                        const stk::mesh::Entity * entities,
+                        const double * rhs,
+                        const double * lhs,
+                        int * meshColIds,
+                        int * entityPermutation,
+                        const bool forceAtomic);
+
+    /** Adds the numDof lhs rows (lhsStride apart) of one node into its block row; meshColIds sorted*/
+    void sum_into_block_row(const LinSys::BlockMatrix & matrix,
+                            const LocalOrdinal meshRowLid,
+                            const int numEntities,
+                            const int * meshColIds,
+                            const int * entityPermutation,
+                            const double * lhsRows,
+                            const size_t lhsStride,
+                            const bool forceAtomic);
+
+    /** Zeroes row d of every block of a node row; the diagonal entry becomes diagonalValue*/
+    void replace_block_row(const LinSys::BlockMatrix & matrix,
+                           const LocalOrdinal meshRowLid,
+                           const LocalOrdinal meshDiagColLid,
+                           const unsigned d,
+                           const double diagonalValue);
+
+    /** Matrix-free sumInto; only the diagonal entry of the lhs row is kept*/
+    void sum_into_diagonal_and_rhs(const LocalOrdinal rowLid, const double diagValue, const double rhsValue, const bool forceAtomic);
+    
     void fill_entity_to_row_LID_mapping();
     void fill_entity_to_col_LID_mapping();
 
+    /** Row LIDs and CSR value offsets of every lhs entry of the locally owned elements
+     *
+     *  Elements with an entry outside the graph (e.g. a ghosted column) get no
+     *  plan and keep the sorted sumInto.
+     */
+    void build_scatter_plan();
+
+    /** Plan of elem, or nullptr; numRows row LIDs followed by numRows*numRows value offsets*/
+    const LocalOrdinal * scatter_plan(stk::mesh::Entity elem) const;
+
+    /** Indexed add of a row-major element lhs and its rhs through a scatter plan*/
+    void sum_into_planned(const LocalOrdinal * plan,
+                          const int numRows,
+                          const double * rhs,
+                          const double * lhs,
+                          const bool forceAtomic);
+
+    /** Dirichlet rows of one set of parts and the entries of their columns in the other rows
+     *
+     *  Built on the first applyDirichletBCs for the parts; the graph is static
+     *  until the next finalizeLinearSystem.
+     */
+    struct DirichletRows {
+        std::vector<stk::mesh::Entity> nodes;
+        std::vector<unsigned> dofs;
+        std::vector<LocalOrdinal> rowLids;
+        // column entries of Dirichlet row k in the rows that are not Dirichlet rows:
+        // couplingStart[k] to couplingStart[k+1]; empty without symmetric elimination
+        std::vector<size_t> couplingStart;
+        std::vector<LocalOrdinal> couplingRowLids;
+        std::vector<size_t> couplingOffsets;
+        std::vector<double> couplingValues;
+    };
+
+    /** Collects the owned and shared Dirichlet rows of parts and, if requested, their column entries*/
+    void build_dirichlet_rows(DirichletRows & bcRows,
+                              stk::mesh::FieldBase * solutionField,
+                              const stk::mesh::PartVector & parts,
+                              const unsigned beginPos,
+                              const unsigned endPos);
+
+    /** CrsMatrix Dirichlet rows from the cached rows; the columns are moved to the rhs with symmetric_dirichlet*/
+    void apply_cached_dirichlet(DirichletRows & bcRows,
+                                stk::mesh::FieldBase * solutionField,
+                                stk::mesh::FieldBase * bcValuesField);
+
+    /** Offset of the diagonal entry in the values of each owned and sharedNotOwned row*/
+    void build_diagonal_offsets();
+    /** Nonblocking point-to-point export of the sharedNotOwned rows
+     *
+     *  Follows the exporter_ plan. The owner of a row keeps the value offsets
+     *  of the sent entries in its owned rows; the graphs are static until the
+     *  next finalizeLinearSystem. A message holds the rhs of its rows followed
+     *  by their values in CSR order.
+     */
+    struct SharedRowExport {
+        bool built{false};
+        bool inFlight{false};
+        // rows to sendProcs[k]: sendRowStart[k] to sendRowStart[k+1]; their values likewise
+        std::vector<int> sendProcs;
+        std::vector<size_t> sendRowStart;
+        std::vector<size_t> sendEntryStart;
+        std::vector<LocalOrdinal> sendRows;
+        // owned rows and value offsets of the messages of recvProcs
+        std::vector<int> recvProcs;
+        std::vector<size_t> recvRowStart;
+        std::vector<size_t> recvEntryStart;
+        std::vector<LocalOrdinal> recvRows;
+        std::vector<size_t> recvOffsets;
+        std::vector<double> sendBuffer;
+        std::vector<double> recvBuffer;
+        std::vector<MPI_Request> requests;
+    };
+    /** Collective; exchanges the gids of the sent rows and columns once*/
+    void build_shared_row_export();
+    /** Waits for the messages of beginLoadComplete and adds them into the owned rows*/
+    void end_shared_row_export();
+
+    /** Greedy distance-1 colouring of the locally owned elements through their nodes*/
+    void color_elements();
+
     void copy_tpetra_to_stk(
       const Teuchos::RCP<LinSys::Vector> tpetraVector,
       stk::mesh::FieldBase * stkField);
@@ -193,6 +385,54 @@ private:
     LocalOrdinal maxSharedNotOwnedRowId_; // = (num_owned_nodes + num_sharedNotOwned_nodes) * numDof_
 
     std::vector<int> sortPermutation_;
+    
+    // matrix-free; only the rhs and the diagonal are assembled
+    const bool matrixFree_;
+    Teuchos::RCP<LinSys::Import> colImporter_;
+    Teuchos::RCP<LinSys::Vector> ownedDiag_;
+    Teuchos::RCP<LinSys::Vector> sharedNotOwnedDiag_;
+    Teuchos::RCP<LinSys::Vector> dirichletMask_;
+    host_view_type ownedLocalDiag_;
+    host_view_type sharedNotOwnedLocalDiag_;
+    host_view_type dirichletLocalMask_;
+
+    // numDof > 1; one graph entry and a dense numDof x numDof block per node pair
+    const bool blockCrs_;
+    Teuchos::RCP<LinSys::Map> ownedMeshMap_;
+    Teuchos::RCP<LinSys::Map> sharedNotOwnedMeshMap_;
+    Teuchos::RCP<LinSys::Map> totalColsMeshMap_;
+    Teuchos::RCP<LinSys::Export> meshExporter_;
+    Teuchos::RCP<LinSys::Graph> ownedBlockGraph_;
+    Teuchos::RCP<LinSys::Graph> sharedNotOwnedBlockGraph_;
+    Teuchos::RCP<LinSys::BlockMatrix> ownedBlockMatrix_;
+    Teuchos::RCP<LinSys::BlockMatrix> sharedNotOwnedBlockMatrix_;
+
+    // scatter plan; start of each element's plan, indexed by the element's local offset
+    std::vector<size_t> scatterPlanStart_;
+    std::vector<LocalOrdinal> scatterPlan_;
+
+    // value offset of the diagonal entry; owned rows followed by the sharedNotOwned rows
+    std::vector<size_t> diagonalOffsets_;
+
+    // initial guess history slot; the index of the solve within the time step
+    int guessTimeStep_;
+    size_t solvesInTimeStep_;
+
+    // Dirichlet rows per set of parts (part ordinals, beginPos, endPos)
+    std::map<std::vector<unsigned>, DirichletRows> dirichletRows_;
+    // overlap_shared_export
+    SharedRowExport sharedRowExport_;
+
+    // constant LHS; the matrix stays fill complete and only the rhs is assembled
+    bool lhsAssembled_;
+    bool rhsOnly_;
+
+    // Dirichlet columns are eliminated into the rhs; keeps a symmetric matrix symmetric
+    const bool symmetricDirichlet_;
+
+    // mesh_cache; recorded graph build calls
+    std::vector<std::pair<GraphBuildType, stk::mesh::PartVector> > deferredGraphBuilds_;
+    bool replayingGraphBuild_;
 };
 
 template<typename T1, typename T2>
@@ -62,8 +62,8 @@ Kernel* build_topo_kernel(int dimension, stk::topology topo, Args&&... args)
 //        return new T<AlgTraitsQuad4_2D>(std::forward<Args>(args)...);
 //      case stk::topology::QUAD_9_2D:
 //        return new T<AlgTraitsQuad9_2D>(std::forward<Args>(args)...);
-//      case stk::topology::TRI_3_2D:
-//        return new T<AlgTraitsTri3_2D>(std::forward<Args>(args)...);
+      case stk::topology::TRI_3_2D:
+        return new T<AlgTraitsTri3_2D>(std::forward<Args>(args)...);
       default:
         return nullptr;
     }
@@ -0,0 +1,64 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#ifndef SCALARDIFFELEMKERNEL_H
+#define SCALARDIFFELEMKERNEL_H
+
+#include <kernel/Kernel.h>
+#include <FieldTypeDef.h>
+
+#include <stk_mesh/base/BulkData.hpp>
+#include <stk_mesh/base/Entity.hpp>
+
+#include <Kokkos_Core.hpp>
+
+class SolutionOptions;
+class MasterElement;
+class ElemDataRequests;
+
+/** CVFEM scalar diffusion kernel
+ *
+ * SIMD version of AssembleScalarElemDiffSolverAlgorithm for the consolidated
+ * solver algorithm (use_consolidated_solver_algorithm: yes). Requested as
+ * "CVFEM_DIFF" in the element_source_terms of the equation.
+ */
+template<typename AlgTraits>
+class ScalarDiffElemKernel: public Kernel
+{
+public:
+  ScalarDiffElemKernel(
+    const stk::mesh::BulkData&,
+    const SolutionOptions&,
+    ScalarFieldType*,
+    ScalarFieldType*,
+    ElemDataRequests&);
+
+  virtual ~ScalarDiffElemKernel();
+
+  /** Execute the kernel within a Kokkos loop and populate the LHS and RHS for
+   *  the linear solve
+   */
+  virtual void execute(
+    SharedMemView<DoubleType**>&,
+    SharedMemView<DoubleType*>&,
+    ScratchViews<DoubleType>&);
+
+private:
+  ScalarDiffElemKernel() = delete;
+
+  ScalarFieldType *scalarQ_{nullptr};
+  ScalarFieldType *diffFluxCoeff_{nullptr};
+  VectorFieldType *coordinates_{nullptr};
+
+  /// Integration point to node mapping
+  const int* lrscv_;
+
+  /// Shift diffusion operator to the edge midpoints
+  const bool shiftedGradOp_;
+
+  /// Shape functions
+  AlignedViewType<DoubleType[AlgTraits::numScsIp_][AlgTraits::nodesPerElement_]> v_shape_function_ { "view_shape_func" };
+};
+
+#endif /* SCALARDIFFELEMKERNEL_H */
@@ -230,6 +230,24 @@ public:
     double *normal) {
     throw std::runtime_error("general_normal not implemented");}
 
+  // element-major evaluation of a whole bucket; coords[nelem][npe][nDim]
+  virtual bool has_batch_eval() const { return false; }
+
+  // scs: areav[nelem][nscs][nDim]; scv: volume[nelem][nscv]
+  virtual void batch_determinant(
+    const int nelem,
+    const double *coords,
+    double *result) {
+    throw std::runtime_error("batch_determinant not implemented");}
+
+  // gradop[nelem][nscs][npe][nDim], det_j[nelem][nscs]; returns the number of bad elements
+  virtual int batch_grad_op(
+    const int nelem,
+    const double *coords,
+    double *gradop,
+    double *det_j) {
+    throw std::runtime_error("batch_grad_op not implemented");}
+
   virtual void sidePcoords_to_elemPcoords(
     const int & side_ordinal,
     const int & npoints,
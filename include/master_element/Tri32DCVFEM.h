@@ -80,6 +80,19 @@ public:
     double *areav,
     double * error );
 
+  bool has_batch_eval() const { return true; }
+
+  void batch_determinant(
+    const int nelem,
+    const double *coords,
+    double *areav);
+
+  int batch_grad_op(
+    const int nelem,
+    const double *coords,
+    double *gradop,
+    double *det_j);
+
   void grad_op(
     SharedMemView<DoubleType**>& coords,
     SharedMemView<DoubleType***>& gradop,
@@ -12,6 +12,9 @@
 #include <stk_topology/topology.hpp>
 
 #include <Realm.h>
+#include <FieldTypeDef.h>
+
+#include <vector>
 
 inline
 void populate_ghost_comm_procs(const stk::mesh::BulkData& bulk_data, stk::mesh::Ghosting& ghosting,
@@ -56,5 +59,25 @@ stk::topology get_elem_topo(const Realm& realm, const stk::mesh::Part& surfacePa
   return elemTopo;
 }
 
+inline
+void gather_bucket_coordinates(const stk::mesh::Bucket& b, const VectorFieldType& coordinates,
+                               const int nDim, std::vector<double>& bucketCoords)
+{
+  // element-major, bucketCoords[k][node][dim]; the layout of MasterElement::batch_* calls
+  const size_t length = b.size();
+  const int nodesPerElement = b.topology().num_nodes();
+  bucketCoords.resize(length*nodesPerElement*nDim);
+
+  for (size_t k = 0; k < length; ++k) {
+    stk::mesh::Entity const * node_rels = b.begin_nodes(k);
+    double * elemCoords = &bucketCoords[k*nodesPerElement*nDim];
+    for (int ni = 0; ni < nodesPerElement; ++ni) {
+      const double * coords = stk::mesh::field_data(coordinates, node_rels[ni]);
+      for (int j = 0; j < nDim; ++j)
+        elemCoords[ni*nDim+j] = coords[j];
+    }
+  }
+}
+
 #endif /* STKHELPERS_H */
 
@@ -75,7 +75,7 @@ AssembleElemSolverAlgorithm::execute()
   for ( size_t i = 0; i < activeKernelsSize; ++i )
     activeKernels_[i]->setup();
 
-  run_algorithm(bulk_data, [&](SharedMemData& smdata)
+  auto assembleLambda = [&](SharedMemData& smdata)
   {
       set_zero(smdata.simdrhs.data(), smdata.simdrhs.size());
       set_zero(smdata.simdlhs.data(), smdata.simdlhs.size());
@@ -87,8 +87,59 @@ AssembleElemSolverAlgorithm::execute()
       for(int simdElemIndex=0; simdElemIndex<smdata.numSimdElems; ++simdElemIndex) {
         extract_vector_lane(smdata.simdrhs, simdElemIndex, smdata.rhs);
         extract_vector_lane(smdata.simdlhs, simdElemIndex, smdata.lhs);
-        apply_coeff(nodesPerEntity_, smdata.elemNodes[simdElemIndex],
+        apply_coeff(smdata.elems[simdElemIndex], nodesPerEntity_, smdata.elemNodes[simdElemIndex],
                     smdata.scratchIds, smdata.sortPermutation, smdata.rhs, smdata.lhs, __FILE__);
       }
-  });
+  };
+
+  LinearSystem * linsys = eqSystem_->linsys_;
+  const bool useColoring = entityRank_ == stk::topology::ELEMENT_RANK && linsys->num_element_colors() > 0;
+  if ( useColoring ) {
+    fill_color_elements();
+    linsys->set_atomic_free_assembly(true);
+    run_algorithm_colored(bulk_data, assembleLambda);
+    linsys->set_atomic_free_assembly(false);
+  }
+  else {
+    run_algorithm(bulk_data, assembleLambda);
+  }
+}
+
+//--------------------------------------------------------------------------
+//-------- fill_color_elements ---------------------------------------------
+//--------------------------------------------------------------------------
+void
+AssembleElemSolverAlgorithm::fill_color_elements()
+{
+  // the colouring is computed by finalizeLinearSystem; it changes with the
+  // mesh or a linear system recreated by reinitialize_linear_system
+  ColorElements & colorElems = colorElems_[region_];
+  const LinearSystem * linsys = eqSystem_->linsys_;
+  const size_t meshCount = realm_.bulk_data().synchronized_count();
+  if ( linsys == colorElems.linsys && meshCount == colorElems.meshCount )
+    return;
+  colorElems.linsys = linsys;
+  colorElems.meshCount = meshCount;
+
+  const std::vector<int> & elemColor = linsys->element_colors();
+  colorElems.elems.assign(linsys->num_element_colors(), std::vector<stk::mesh::Entity>());
+
+  stk::mesh::MetaData & meta_data = realm_.meta_data();
+  stk::mesh::Selector elemSelector =
+          meta_data.locally_owned_part()
+        & stk::mesh::selectUnion(partVec_)
+        & !realm_.get_inactive_selector()
+        & realm_.assembly_region_selector(region_);
+
+  stk::mesh::BucketVector const& elem_buckets =
+          realm_.get_buckets(entityRank_, elemSelector );
+
+  for ( const stk::mesh::Bucket* bptr : elem_buckets ) {
+    const stk::mesh::Bucket & b = *bptr;
+    for ( stk::mesh::Entity element : b ) {
+      const int color = elemColor[element.local_offset()];
+      ThrowAssert(color >= 0);
+      colorElems.elems[color].push_back(element);
+    }
+  }
 }
\ No newline at end of file
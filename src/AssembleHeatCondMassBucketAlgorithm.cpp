@@ -0,0 +1,119 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "AssembleHeatCondMassBucketAlgorithm.h"
+
+#include <EquationSystem.h>
+#include <SolverAlgorithm.h>
+
+#include <FieldTypeDef.h>
+#include <LinearSystem.h>
+#include <Realm.h>
+
+// stk_mesh/base/fem
+#include <stk_mesh/base/BulkData.hpp>
+#include <stk_mesh/base/Field.hpp>
+#include <stk_mesh/base/GetBuckets.hpp>
+#include <stk_mesh/base/MetaData.hpp>
+#include <stk_mesh/base/Part.hpp>
+
+#include <stk_util/util/ReportHandler.hpp>
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// AssembleHeatCondMassBucketAlgorithm - lumped mass LHS/RHS per bucket
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+AssembleHeatCondMassBucketAlgorithm::AssembleHeatCondMassBucketAlgorithm(
+    Realm &realm,
+    stk::mesh::Part *part,
+    EquationSystem *eqSystem,
+    const bool useBDF2) :
+        SolverAlgorithm(realm, part, eqSystem),
+        useBDF2_(useBDF2),
+        temperatureNm1_(NULL),
+        temperatureN_(NULL),
+        temperatureNp1_(NULL),
+        density_(NULL),
+        specificHeat_(NULL),
+        dualNodalVolume_(NULL)
+{
+    ThrowRequireMsg(eqSystem->linsys_->numDof() == 1, "AssembleHeatCondMassBucketAlgorithm: single dof system expected");
+
+    // save off fields
+    stk::mesh::MetaData & meta_data = realm_.meta_data();
+    ScalarFieldType *temperature = meta_data.get_field<ScalarFieldType>(stk::topology::NODE_RANK, "temperature");
+    if ( useBDF2_ )
+        temperatureNm1_ = &(temperature->field_of_state(stk::mesh::StateNM1));
+    temperatureN_ = &(temperature->field_of_state(stk::mesh::StateN));
+    temperatureNp1_ = &(temperature->field_of_state(stk::mesh::StateNP1));
+    density_ = meta_data.get_field<ScalarFieldType>(stk::topology::NODE_RANK, "density");
+    specificHeat_ = meta_data.get_field<ScalarFieldType>(stk::topology::NODE_RANK, "specific_heat");
+    dualNodalVolume_ = meta_data.get_field<ScalarFieldType>(stk::topology::NODE_RANK, "dual_nodal_volume");
+}
+
+//--------------------------------------------------------------------------
+//-------- initialize_connectivity -----------------------------------------
+//--------------------------------------------------------------------------
+void AssembleHeatCondMassBucketAlgorithm::initialize_connectivity() {
+    eqSystem_->linsys_->buildNodeGraph(partVec_);
+}
+
+//--------------------------------------------------------------------------
+//-------- execute ---------------------------------------------------------
+//--------------------------------------------------------------------------
+void AssembleHeatCondMassBucketAlgorithm::execute() {
+    stk::mesh::MetaData & meta_data = realm_.meta_data();
+
+    // backward Euler is gamma = (1, -1, 0)
+    const double dt = realm_.get_time_step();
+    const double gamma1 = useBDF2_ ? realm_.get_gamma1() : 1.0;
+    const double gamma2 = useBDF2_ ? realm_.get_gamma2() : -1.0;
+    const double gamma3 = useBDF2_ ? realm_.get_gamma3() : 0.0;
+    const double invDt = 1.0/dt;
+
+    // same nodes as AssembleNodeSolverAlgorithm
+    stk::mesh::Selector s_locally_owned_union = meta_data.locally_owned_part()
+        & stk::mesh::selectUnion(partVec_)
+        & !(stk::mesh::selectUnion(realm_.get_slave_part_vector()))
+        & !(realm_.get_inactive_selector());
+
+    stk::mesh::BucketVector const & node_buckets = realm_.get_buckets( stk::topology::NODE_RANK, s_locally_owned_union );
+    for ( stk::mesh::BucketVector::const_iterator ib = node_buckets.begin(); ib != node_buckets.end() ; ++ib ) {
+        stk::mesh::Bucket & b = **ib;
+        const stk::mesh::Bucket::size_type length = b.size();
+
+        lhsBucket_.resize(length);
+        rhsBucket_.resize(length);
+        double * p_lhs = &lhsBucket_[0];
+        double * p_rhs = &rhsBucket_[0];
+
+        const double * tN = stk::mesh::field_data(*temperatureN_, b);
+        const double * tNp1 = stk::mesh::field_data(*temperatureNp1_, b);
+        const double * rho = stk::mesh::field_data(*density_, b);
+        const double * cp = stk::mesh::field_data(*specificHeat_, b);
+        const double * dualVolume = stk::mesh::field_data(*dualNodalVolume_, b);
+
+        if ( useBDF2_ ) {
+            const double * tNm1 = stk::mesh::field_data(*temperatureNm1_, b);
+            for ( stk::mesh::Bucket::size_type k = 0; k < length; ++k ) {
+                const double lhsTime = rho[k]*cp[k]*dualVolume[k]*invDt;
+                p_rhs[k] = -lhsTime*(gamma1*tNp1[k] + gamma2*tN[k] + gamma3*tNm1[k]);
+                p_lhs[k] = lhsTime;
+            }
+        }
+        else {
+            for ( stk::mesh::Bucket::size_type k = 0; k < length; ++k ) {
+                const double lhsTime = rho[k]*cp[k]*dualVolume[k]*invDt;
+                p_rhs[k] = -lhsTime*(gamma1*tNp1[k] + gamma2*tN[k]);
+                p_lhs[k] = lhsTime;
+            }
+        }
+
+        eqSystem_->linsys_->sumIntoDiagonal(length, b.begin(), p_lhs, p_rhs);
+    }
+}
@@ -7,8 +7,11 @@
 
 #include <FieldTypeDef.h>
 #include <Realm.h>
+#include <ElemGeometryCache.h>
 //#include <TimeIntegrator.h>
 #include <master_element/MasterElement.h>
+#include <KokkosInterface.h>
+#include <utils/StkHelpers.h>
 
 // stk_mesh/base/fem
 #include <stk_mesh/base/BulkData.hpp>
@@ -17,7 +20,14 @@
 #include <stk_mesh/base/MetaData.hpp>
 #include <stk_mesh/base/Part.hpp>
 
+#include <stk_util/util/ReportHandler.hpp>
+
 struct nodalGradientElem{
+  // upper bounds for the per-element scratch arrays (Hex27 CVFEM)
+  static constexpr int maxNodesPerElement = 27;
+  static constexpr int maxScsIp = 216;
+  static constexpr int maxDim = 3;
+
 private:
 
   //Bucket and Element Data
@@ -29,6 +39,8 @@ private:
   ScalarFieldType & scalarQ_;
   ScalarFieldType & dualNodalVolume_;
   VectorFieldType & coordinates_;
+  const ElemGeometryCache * geomCache_;
+  const double * bucketScsAreav_;
 
   //OutputFields
   VectorFieldType & dqdx_;
@@ -39,36 +51,37 @@ private:
   const int numScsIp_;
   const int nodesPerElement_;
 
-  // temporary arrays
-  std::vector<double> p_scalarQ;
-  std::vector<double> p_dualVolume;
-  std::vector<double> p_coordinates;
-  std::vector<double> p_scs_areav;
-
 public:
   nodalGradientElem(stk::mesh::Bucket & b, MasterElement & meSCS,
       double * p_shape_function,
       ScalarFieldType & scalarQ, VectorFieldType & dqdx,
       ScalarFieldType & dualNodalVolume, VectorFieldType & coordinates,
-      int nDim):
+      const ElemGeometryCache * geomCache, const double * bucketScsAreav, int nDim):
       b_(b),
       meSCS_(meSCS),
       p_shape_function_(p_shape_function),
       scalarQ_(scalarQ),
       dualNodalVolume_(dualNodalVolume),
       coordinates_(coordinates),
+      geomCache_(geomCache),
+      bucketScsAreav_(bucketScsAreav),
       dqdx_(dqdx),
       nDim_(nDim),
       numScsIp_(meSCS_.numIntPoints_),
-      nodesPerElement_(meSCS_.nodesPerElement_),
-      p_scalarQ(nodesPerElement_),
-      p_dualVolume(nodesPerElement_),
-      p_coordinates(nodesPerElement_*nDim_),
-      p_scs_areav(numScsIp_*nDim_)
+      nodesPerElement_(meSCS_.nodesPerElement_)
   {
+    ThrowRequire(nodesPerElement_ <= maxNodesPerElement && numScsIp_ <= maxScsIp && nDim_ <= maxDim);
     lrscv = meSCS_.adjacentNodes();
   }
-  void operator()(stk::mesh::Bucket::size_type elem_offset){
+
+  // thread-safe; scratch lives on the stack and the nodal scatter is atomic
+  void operator()(stk::mesh::Bucket::size_type elem_offset) const {
+    // temporary arrays
+    double p_scalarQ[maxNodesPerElement];
+    double p_dualVolume[maxNodesPerElement];
+    double p_coordinates[maxNodesPerElement*maxDim];
+    double p_scs_areav[maxScsIp*maxDim];
+
     // get elem
     //===============================================
     // gather nodal data; this is how we do it now..
@@ -76,25 +89,34 @@ public:
     stk::mesh::Entity const * node_rels = b_.begin_nodes(elem_offset);
     const int num_nodes = b_.num_nodes(elem_offset);
 
+    // static geometry from the element cache or the bucket batch, if any
+    const double * p_elem_scs_areav = (NULL != geomCache_) ? geomCache_->scs_areav(b_[elem_offset]) : NULL;
+    if ( NULL == p_elem_scs_areav && NULL != bucketScsAreav_ )
+      p_elem_scs_areav = bucketScsAreav_ + elem_offset*numScsIp_*nDim_;
+
     for ( int ni = 0; ni < num_nodes; ++ni ) {
       stk::mesh::Entity node = node_rels[ni];
 
-      const double * coords = stk::mesh::field_data(coordinates_, node );
-
       // gather scalars
       p_scalarQ[ni]    = *stk::mesh::field_data(scalarQ_, node);
       p_dualVolume[ni] = *stk::mesh::field_data(dualNodalVolume_, node);
 
-      // gather vectors
-      const int offSet = ni*nDim_;
-      for ( int j=0; j < nDim_; ++j ) {
-        p_coordinates[offSet+j] = coords[j];
+      // gather vectors; only needed when the geometry is computed here
+      if ( NULL == p_elem_scs_areav ) {
+        const double * coords = stk::mesh::field_data(coordinates_, node );
+        const int offSet = ni*nDim_;
+        for ( int j=0; j < nDim_; ++j ) {
+          p_coordinates[offSet+j] = coords[j];
+        }
       }
     }
 
     // compute geometry
-    double scs_error = 0.0;
-    meSCS_.determinant(1, &p_coordinates[0], &p_scs_areav[0], &scs_error);
+    if ( NULL == p_elem_scs_areav ) {
+      double scs_error = 0.0;
+      meSCS_.determinant(1, &p_coordinates[0], &p_scs_areav[0], &scs_error);
+      p_elem_scs_areav = p_scs_areav;
+    }
 
     // start assembly
     for ( int ip = 0; ip < numScsIp_; ++ip ) {
@@ -121,11 +143,11 @@ public:
       double inv_volL = 1.0/p_dualVolume[il];
       double inv_volR = 1.0/p_dualVolume[ir];
 
-      // assemble to il/ir
+      // assemble to il/ir; nodes are shared with neighbouring elements
       for ( int j = 0; j < nDim_; ++j ) {
-        double fac = qIp*p_scs_areav[ip*nDim_+j];
-        gradQL[j] += fac*inv_volL;
-        gradQR[j] -= fac*inv_volR;
+        double fac = qIp*p_elem_scs_areav[ip*nDim_+j];
+        Kokkos::atomic_add(&gradQL[j], fac*inv_volL);
+        Kokkos::atomic_add(&gradQR[j], -fac*inv_volR);
       }
     }
    }
@@ -169,6 +191,8 @@ AssembleNodalGradElemAlgorithm::execute()
 
   const int nDim = meta_data.spatial_dimension();
   std::vector<double> ws_shape_function;
+  std::vector<double> ws_bucket_coordinates;
+  std::vector<double> ws_bucket_scs_areav;
 
   // define some common selectors
   stk::mesh::Selector s_locally_owned_union = meta_data.locally_owned_part()
@@ -193,11 +217,19 @@ AssembleNodalGradElemAlgorithm::execute()
     else
       meSCS->shape_fcn(&p_shape_function[0]);
 
-    nodalGradientElem nodeGradFunctor(b, *meSCS, p_shape_function, *scalarQ_, *dqdx_, *dualNodalVolume_, *coordinates_, nDim);
+    // linear tets and triangles: area vectors of the whole bucket in one call
+    const double * p_bucket_scs_areav = NULL;
+    if ( meSCS->has_batch_eval() && NULL == realm_.elemGeometryCache_ ) {
+      gather_bucket_coordinates(b, *coordinates_, nDim, ws_bucket_coordinates);
+      ws_bucket_scs_areav.resize(length*numScsIp*nDim);
+      meSCS->batch_determinant(length, &ws_bucket_coordinates[0], &ws_bucket_scs_areav[0]);
+      p_bucket_scs_areav = &ws_bucket_scs_areav[0];
+    }
 
-    for ( stk::mesh::Bucket::size_type k = 0 ; k < length ; ++k ) {
-      //WARNING: do not thread this functor.  It is not thread-safe because each element scatters to all of its nodes.
+    const nodalGradientElem nodeGradFunctor(b, *meSCS, p_shape_function, *scalarQ_, *dqdx_, *dualNodalVolume_, *coordinates_, realm_.elemGeometryCache_, p_bucket_scs_areav, nDim);
+
+    kokkos_parallel_for("AssembleNodalGradElemAlgorithm::execute", length, [&] (const stk::mesh::Bucket::size_type& k) {
       nodeGradFunctor(k);
-    }
+    });
   }
 }
\ No newline at end of file
@@ -0,0 +1,154 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "AssembleScalarEdgeDiffSolverAlgorithm.h"
+
+#include <EquationSystem.h>
+#include <SolverAlgorithm.h>
+
+#include <FieldTypeDef.h>
+#include <LinearSystem.h>
+#include <Realm.h>
+
+// stk_mesh/base/fem
+#include <stk_mesh/base/BulkData.hpp>
+#include <stk_mesh/base/Field.hpp>
+#include <stk_mesh/base/GetBuckets.hpp>
+#include <stk_mesh/base/MetaData.hpp>
+#include <stk_mesh/base/Part.hpp>
+
+#include <stk_util/util/ReportHandler.hpp>
+
+#include <vector>
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// AssembleScalarEdgeDiffSolverAlgorithm - add LHS/RHS for scalar diff
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+AssembleScalarEdgeDiffSolverAlgorithm::AssembleScalarEdgeDiffSolverAlgorithm(
+    Realm &realm,
+    stk::mesh::Part *part,
+    EquationSystem *eqSystem,
+    ScalarFieldType *scalarQ,
+    VectorFieldType *dqdx,
+    ScalarFieldType *diffFluxCoeff) :
+        SolverAlgorithm(realm, part, eqSystem),
+        scalarQ_(scalarQ),
+        dqdx_(dqdx),
+        diffFluxCoeff_(diffFluxCoeff)
+{
+    // save off fields
+    stk::mesh::MetaData & meta_data = realm_.meta_data();
+    coordinates_ = meta_data.get_field<VectorFieldType>(stk::topology::NODE_RANK, realm_.get_coordinates_name());
+    edgeAreaVec_ = meta_data.get_field<VectorFieldType>(stk::topology::EDGE_RANK, "edge_area_vector");
+    ThrowRequireMsg(NULL != edgeAreaVec_, "AssembleScalarEdgeDiffSolverAlgorithm: edge_area_vector is not registered");
+}
+
+//--------------------------------------------------------------------------
+//-------- initialize_connectivity -----------------------------------------
+//--------------------------------------------------------------------------
+void AssembleScalarEdgeDiffSolverAlgorithm::initialize_connectivity() {
+    eqSystem_->linsys_->buildEdgeToNodeGraph(partVec_);
+}
+
+//--------------------------------------------------------------------------
+//-------- execute ---------------------------------------------------------
+//--------------------------------------------------------------------------
+void AssembleScalarEdgeDiffSolverAlgorithm::execute() {
+    stk::mesh::MetaData & meta_data = realm_.meta_data();
+
+    const int nDim = meta_data.spatial_dimension();
+
+    // space for LHS/RHS; always nodesPerEdge*nodesPerEdge and nodesPerEdge
+    std::vector<double> lhs(4);
+    std::vector<double> rhs(2);
+    std::vector<int> scratchIds(2);
+    std::vector<double> scratchVals(2);
+    std::vector<stk::mesh::Entity> connected_nodes(2);
+
+    // deal with state
+    ScalarFieldType & scalarQNp1 = scalarQ_->field_of_state(stk::mesh::StateNP1);
+
+    // edges are owned by one process; the shared rows are exported by the linear system
+    stk::mesh::Selector s_locally_owned_union = meta_data.locally_owned_part()
+        & stk::mesh::selectUnion(partVec_)
+        & !(realm_.get_inactive_selector())
+        & realm_.assembly_region_selector(region_);
+
+    stk::mesh::BucketVector const & edge_buckets = realm_.get_buckets( stk::topology::EDGE_RANK, s_locally_owned_union );
+    for ( stk::mesh::BucketVector::const_iterator ib = edge_buckets.begin(); ib != edge_buckets.end() ; ++ib ) {
+        stk::mesh::Bucket & b = **ib;
+        const stk::mesh::Bucket::size_type length = b.size();
+
+        // pointer to edge area vector
+        const double * av = stk::mesh::field_data(*edgeAreaVec_, b);
+
+        for ( stk::mesh::Bucket::size_type k = 0; k < length; ++k ) {
+            stk::mesh::Entity const * edge_node_rels = b.begin_nodes(k);
+
+            // sanity check on number of nodes
+            ThrowAssert( b.num_nodes(k) == 2 );
+
+            // left and right nodes; the area vector points from left to right
+            stk::mesh::Entity nodeL = edge_node_rels[0];
+            stk::mesh::Entity nodeR = edge_node_rels[1];
+            connected_nodes[0] = nodeL;
+            connected_nodes[1] = nodeR;
+
+            // extract nodal fields
+            const double * coordL = stk::mesh::field_data(*coordinates_, nodeL);
+            const double * coordR = stk::mesh::field_data(*coordinates_, nodeR);
+            const double * dqdxL = stk::mesh::field_data(*dqdx_, nodeL);
+            const double * dqdxR = stk::mesh::field_data(*dqdx_, nodeR);
+
+            const double qNp1L = *stk::mesh::field_data(scalarQNp1, nodeL);
+            const double qNp1R = *stk::mesh::field_data(scalarQNp1, nodeR);
+            const double diffFluxCoeffL = *stk::mesh::field_data(*diffFluxCoeff_, nodeL);
+            const double diffFluxCoeffR = *stk::mesh::field_data(*diffFluxCoeff_, nodeR);
+
+            // compute geometry
+            const double * areaVec = &av[k*nDim];
+            double axdx = 0.0;
+            double asq = 0.0;
+            for ( int j = 0; j < nDim; ++j ) {
+                const double axj = areaVec[j];
+                const double dxj = coordR[j] - coordL[j];
+                asq += axj*axj;
+                axdx += axj*dxj;
+            }
+            const double inv_axdx = 1.0/axdx;
+
+            // linear interpolation to the edge midpoint, as the element shape functions
+            const double diffFluxCoeffIp = 0.5*(diffFluxCoeffL + diffFluxCoeffR);
+
+            // non-orthogonal correction; the part of the area vector not along the edge
+            double nonOrth = 0.0;
+            for ( int j = 0; j < nDim; ++j ) {
+                const double kxj = areaVec[j] - asq*inv_axdx*(coordR[j] - coordL[j]);
+                const double GjIp = 0.5*(dqdxL[j] + dqdxR[j]);
+                nonOrth += -diffFluxCoeffIp*kxj*GjIp;
+            }
+
+            // diffusive flux from left to right
+            const double lhsfac = -diffFluxCoeffIp*asq*inv_axdx;
+            const double diffFlux = lhsfac*(qNp1R - qNp1L) + nonOrth;
+
+            // left node
+            lhs[0] = -lhsfac;
+            lhs[1] = +lhsfac;
+            rhs[0] = -diffFlux;
+
+            // right node
+            lhs[2] = +lhsfac;
+            lhs[3] = -lhsfac;
+            rhs[1] = diffFlux;
+
+            apply_coeff(connected_nodes, scratchIds, scratchVals, rhs, lhs, __FILE__);
+        }
+    }
+}
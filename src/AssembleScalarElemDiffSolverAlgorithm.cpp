@@ -10,9 +10,12 @@
 #include <FieldTypeDef.h>
 #include <LinearSystem.h>
 #include <Realm.h>
+#include <HOFlowEnv.h>
+#include <ElemGeometryCache.h>
 #include <SupplementalAlgorithm.h>
 #include <TimeIntegrator.h>
 #include <master_element/MasterElement.h>
+#include <utils/StkHelpers.h>
 #include <iostream>
 
 // stk_mesh/base/fem
@@ -38,13 +41,17 @@ AssembleScalarElemDiffSolverAlgorithm::AssembleScalarElemDiffSolverAlgorithm(
     VectorFieldType *dqdx,
     ScalarFieldType *diffFluxCoeff) : 
         SolverAlgorithm(realm, part, eqSystem),
+        computeNodalGradient_(false),
+        useShiftedNodalGradient_(false),
         scalarQ_(scalarQ),
+        dqdx_(dqdx),
         diffFluxCoeff_(diffFluxCoeff),
         shiftedGradOp_(realm.get_shifted_grad_op(scalarQ_->name()))
 {
     // save off fields
     stk::mesh::MetaData & meta_data = realm_.meta_data();
     coordinates_ = meta_data.get_field<VectorFieldType>(stk::topology::NODE_RANK, realm_.get_coordinates_name());
+    dualNodalVolume_ = meta_data.get_field<ScalarFieldType>(stk::topology::NODE_RANK, "dual_nodal_volume");
 }
 
 //--------------------------------------------------------------------------
@@ -82,6 +89,7 @@ void AssembleScalarElemDiffSolverAlgorithm::execute() {
     std::vector<double> ws_coordinates;
     std::vector<double> ws_scalarQNp1;
     std::vector<double> ws_diffFluxCoeff;
+    std::vector<double> ws_dualVolume;
 
     // geometry related to populate
     std::vector<double> ws_scs_areav;
@@ -89,11 +97,26 @@ void AssembleScalarElemDiffSolverAlgorithm::execute() {
     std::vector<double> ws_deriv;
     std::vector<double> ws_det_j;
     std::vector<double> ws_shape_function;
+    std::vector<double> ws_grad_shape_function;
+
+    // bucket geometry of the batched master element path
+    std::vector<double> ws_bucket_coordinates;
+    std::vector<double> ws_bucket_scs_areav;
+    std::vector<double> ws_bucket_dndx;
+    std::vector<double> ws_bucket_det_j;
+
+    // fused nodal gradient; the loop below is serial, so the nodal scatter needs no atomics
+    const bool computeNodalGradient = computeNodalGradient_ && (NULL != dqdx_);
+
+    // static geometry may come from the element cache; only the unshifted dndx is cached
+    const ElemGeometryCache * geomCache = realm_.elemGeometryCache_;
+    const bool useCachedDndx = (NULL != geomCache) && !shiftedGradOp_;
 
     // define some common selectors
     stk::mesh::Selector s_locally_owned_union = meta_data.locally_owned_part()
         & stk::mesh::selectUnion(partVec_) 
-        & !(realm_.get_inactive_selector());
+        & !(realm_.get_inactive_selector())
+        & realm_.assembly_region_selector(region_);
     
     // Iterate through all element buckets
     stk::mesh::BucketVector const & elem_buckets = realm_.get_buckets( stk::topology::ELEMENT_RANK, s_locally_owned_union );
@@ -110,6 +133,21 @@ void AssembleScalarElemDiffSolverAlgorithm::execute() {
         const int numScsIp = meSCS->numIntPoints_;
         const int * lrscv = meSCS->adjacentNodes();
 
+        // linear tets and triangles evaluate the geometry of the whole bucket in one call;
+        // their gradient operator is constant, so shifted and standard coincide
+        const bool batchGeometry = meSCS->has_batch_eval() && !useCachedDndx;
+        const int areavSize = numScsIp*nDim;
+        const int dndxSize = numScsIp*nodesPerElement*nDim;
+        if ( batchGeometry ) {
+            gather_bucket_coordinates(b, *coordinates_, nDim, ws_bucket_coordinates);
+            ws_bucket_scs_areav.resize(length*areavSize);
+            ws_bucket_dndx.resize(length*dndxSize);
+            ws_bucket_det_j.resize(length*numScsIp);
+            meSCS->batch_determinant(length, &ws_bucket_coordinates[0], &ws_bucket_scs_areav[0]);
+            if ( meSCS->batch_grad_op(length, &ws_bucket_coordinates[0], &ws_bucket_dndx[0], &ws_bucket_det_j[0]) > 0 )
+                HOFlowEnv::self().hoflowOutput() << "sorry, negative element volume in " << b.topology().name() << " bucket.." << std::endl;
+        }
+
         // resize some things; matrix related
         const int lhsSize = nodesPerElement*nodesPerElement;
         const int rhsSize = nodesPerElement;
@@ -128,6 +166,7 @@ void AssembleScalarElemDiffSolverAlgorithm::execute() {
         ws_deriv.resize(nDim*numScsIp*nodesPerElement);
         ws_det_j.resize(numScsIp);
         ws_shape_function.resize(numScsIp*nodesPerElement);
+        ws_dualVolume.resize(nodesPerElement);
 
         // pointer to lhs/rhs
         double * p_lhs = &lhs[0];
@@ -144,6 +183,14 @@ void AssembleScalarElemDiffSolverAlgorithm::execute() {
         // extract shape function
         meSCS->shape_fcn(&p_shape_function[0]);
 
+        // shape function of the nodal gradient; may be shifted
+        const double * p_grad_shape_function = p_shape_function;
+        if ( computeNodalGradient && useShiftedNodalGradient_ ) {
+            ws_grad_shape_function.resize(numScsIp*nodesPerElement);
+            meSCS->shifted_shape_fcn(&ws_grad_shape_function[0]);
+            p_grad_shape_function = &ws_grad_shape_function[0];
+        }
+
         // resize possible supplemental element alg
         for ( size_t i = 0; i < supplementalAlgSize; ++i )
             supplementalAlg_[i]->elem_resize(meSCS, meSCV);
@@ -175,29 +222,43 @@ void AssembleScalarElemDiffSolverAlgorithm::execute() {
                 // set connected nodes
                 connected_nodes[ni] = node;
 
-                // pointers to real data, get coordinates of the node
-                const double * coords = stk::mesh::field_data(*coordinates_, node );
-
                 // gather scalars, get field value of the node
                 p_scalarQNp1[ni]    = *stk::mesh::field_data(scalarQNp1, node );
                 p_diffFluxCoeff[ni] = *stk::mesh::field_data(*diffFluxCoeff_, node );
+                if ( computeNodalGradient )
+                    ws_dualVolume[ni] = *stk::mesh::field_data(*dualNodalVolume_, node );
 
                 // gather vectors, get coordinates for each dimension of the node
-                const int niNdim = ni*nDim;
-                for ( int i=0; i < nDim; ++i ) {
-                    p_coordinates[niNdim+i] = coords[i];
+                if ( !batchGeometry ) {
+                    const double * coords = stk::mesh::field_data(*coordinates_, node );
+                    const int niNdim = ni*nDim;
+                    for ( int i=0; i < nDim; ++i ) {
+                        p_coordinates[niNdim+i] = coords[i];
+                    }
                 }
             }
 
-            // compute geometry
+            // compute geometry, or stream it from the cache or the bucket batch
             double scs_error = 0.0;
-            meSCS->determinant(1, &p_coordinates[0], &p_scs_areav[0], &scs_error);
+            const double * p_elem_scs_areav = (NULL != geomCache) ? geomCache->scs_areav(elem) : NULL;
+            if ( NULL == p_elem_scs_areav && batchGeometry )
+                p_elem_scs_areav = &ws_bucket_scs_areav[k*areavSize];
+            if ( NULL == p_elem_scs_areav ) {
+                meSCS->determinant(1, &p_coordinates[0], &p_scs_areav[0], &scs_error);
+                p_elem_scs_areav = p_scs_areav;
+            }
 
             // compute dndx
-            if ( shiftedGradOp_ )
-                meSCS->shifted_grad_op(1, &ws_coordinates[0], &ws_dndx[0], &ws_deriv[0], &ws_det_j[0], &scs_error);
-            else
-                meSCS->grad_op(1, &ws_coordinates[0], &ws_dndx[0], &ws_deriv[0], &ws_det_j[0], &scs_error);
+            const double * p_elem_dndx = useCachedDndx ? geomCache->dndx(elem) : NULL;
+            if ( batchGeometry )
+                p_elem_dndx = &ws_bucket_dndx[k*dndxSize];
+            if ( NULL == p_elem_dndx ) {
+                if ( shiftedGradOp_ )
+                    meSCS->shifted_grad_op(1, &ws_coordinates[0], &ws_dndx[0], &ws_deriv[0], &ws_det_j[0], &scs_error);
+                else
+                    meSCS->grad_op(1, &ws_coordinates[0], &ws_dndx[0], &ws_deriv[0], &ws_det_j[0], &scs_error);
+                p_elem_dndx = p_dndx;
+            }
             
             // Iterate through all integration points
             for ( int ip = 0; ip < numScsIp; ++ip ) {
@@ -230,8 +291,8 @@ void AssembleScalarElemDiffSolverAlgorithm::execute() {
                     const int offSetDnDx = nDim*nodesPerElement*ip + ic*nDim;
                     // Iterate through all spatial dimensions
                     for ( int j = 0; j < nDim; ++j ) {
-                        const double dndx = getSFDeriv(p_dndx, &offSetDnDx, &j);
-                        const double areav = getFaceDet(p_scs_areav, &nDim, &ip, &j);
+                        const double dndx = getSFDeriv(p_elem_dndx, &offSetDnDx, &j);
+                        const double areav = getFaceDet(p_elem_scs_areav, &nDim, &ip, &j);
                         
                         lhsfacDiff += -muIp*dndx*areav;
                         
@@ -252,13 +313,30 @@ void AssembleScalarElemDiffSolverAlgorithm::execute() {
                 // rhs; il then ir
                 p_rhs[il] -= qDiff;
                 p_rhs[ir] += qDiff;        
+
+                // Green-Gauss gradient from the same gathered state and scs geometry
+                if ( computeNodalGradient ) {
+                    double qIp = 0.0;
+                    for ( int ic = 0; ic < nodesPerElement; ++ic )
+                        qIp += p_grad_shape_function[offSetSF+ic]*p_scalarQNp1[ic];
+
+                    double * gradQL = stk::mesh::field_data(*dqdx_, connected_nodes[il]);
+                    double * gradQR = stk::mesh::field_data(*dqdx_, connected_nodes[ir]);
+                    const double inv_volL = 1.0/ws_dualVolume[il];
+                    const double inv_volR = 1.0/ws_dualVolume[ir];
+                    for ( int j = 0; j < nDim; ++j ) {
+                        const double fac = qIp*p_elem_scs_areav[ip*nDim+j];
+                        gradQL[j] += fac*inv_volL;
+                        gradQR[j] -= fac*inv_volR;
+                    }
+                }
             }
 
             // call supplemental
             for ( size_t i = 0; i < supplementalAlgSize; ++i )
                 supplementalAlg_[i]->elem_execute( &lhs[0], &rhs[0], elem, meSCS, meSCV);
 
-            apply_coeff(connected_nodes, scratchIds, scratchVals, rhs, lhs, __FILE__);
+            apply_coeff(elem, connected_nodes, scratchIds, scratchVals, rhs, lhs, __FILE__);
         }
     }
 }
@@ -0,0 +1,104 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "AsyncOutputWriter.h"
+
+#include <HOFlowEnv.h>
+
+#include <utility>
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// AsyncOutputWriter - output tasks on a writer thread
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+AsyncOutputWriter::AsyncOutputWriter() :
+    busy_(false),
+    shutdown_(false),
+    waitTime_(0.0)
+{
+    thread_ = std::thread(&AsyncOutputWriter::run, this);
+}
+
+//--------------------------------------------------------------------------
+//-------- destructor ------------------------------------------------------
+//--------------------------------------------------------------------------
+AsyncOutputWriter::~AsyncOutputWriter()
+{
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return !busy_; });
+        shutdown_ = true;
+    }
+    condition_.notify_all();
+    thread_.join();
+}
+
+//--------------------------------------------------------------------------
+//-------- submit ----------------------------------------------------------
+//--------------------------------------------------------------------------
+void
+AsyncOutputWriter::submit(std::function<void()> task)
+{
+    wait();
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        task_ = std::move(task);
+        busy_ = true;
+    }
+    condition_.notify_all();
+}
+
+//--------------------------------------------------------------------------
+//-------- wait ------------------------------------------------------------
+//--------------------------------------------------------------------------
+double
+AsyncOutputWriter::wait()
+{
+    const double timeA = HOFlowEnv::self().hoflow_time();
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [this] { return !busy_; });
+        std::swap(error, error_);
+    }
+    const double waited = HOFlowEnv::self().hoflow_time() - timeA;
+    waitTime_ += waited;
+
+    if ( error )
+        std::rethrow_exception(error);
+    return waited;
+}
+
+//--------------------------------------------------------------------------
+//-------- run -------------------------------------------------------------
+//--------------------------------------------------------------------------
+void
+AsyncOutputWriter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while ( true ) {
+        condition_.wait(lock, [this] { return busy_ || shutdown_; });
+        if ( !busy_ )
+            return;
+
+        std::function<void()> task = std::move(task_);
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            task();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+
+        error_ = error;
+        busy_ = false;
+        condition_.notify_all();
+    }
+}
@@ -55,6 +55,22 @@ void ComputeGeometryAlgorithmDriver::pre_work() {
             nv[k] = 0.0;
         }
     }
+
+    // edge area vector, summed from the elements
+    if ( realm_.realmUsesEdges_ ) {
+        VectorFieldType *edgeAreaVec = meta_data.get_field<VectorFieldType>(stk::topology::EDGE_RANK, "edge_area_vector");
+        stk::mesh::Selector s_all_edges = (meta_data.locally_owned_part() | meta_data.globally_shared_part())
+                &stk::mesh::selectField(*edgeAreaVec);
+        stk::mesh::BucketVector const& edge_buckets = realm_.get_buckets( stk::topology::EDGE_RANK, s_all_edges );
+        for ( stk::mesh::BucketVector::const_iterator ib = edge_buckets.begin(); ib != edge_buckets.end() ; ++ib ) {
+            stk::mesh::Bucket & b = **ib ;
+            const stk::mesh::Bucket::size_type length   = b.size();
+            double * av = stk::mesh::field_data( *edgeAreaVec, b);
+            for ( stk::mesh::Bucket::size_type k = 0 ; k < length*nDim ; ++k ) {
+                av[k] = 0.0;
+            }
+        }
+    }
 }
 
 void ComputeGeometryAlgorithmDriver::post_work() {
@@ -68,6 +84,12 @@ void ComputeGeometryAlgorithmDriver::post_work() {
     // Spread the value on all parts of the mesh
     stk::mesh::parallel_sum(bulk_data, {dualNodalVolume});
 
+    // edges on the process boundary collect the scs of elements of several processes
+    if ( realm_.realmUsesEdges_ ) {
+        VectorFieldType *edgeAreaVec = meta_data.get_field<VectorFieldType>(stk::topology::EDGE_RANK, "edge_area_vector");
+        stk::mesh::parallel_sum(bulk_data, {edgeAreaVec});
+    }
+
     if ( realm_.checkJacobians_ ) {
         check_jacobians();
     }
@@ -5,8 +5,11 @@
 #include "ComputeGeometryInteriorAlgorithm.h"
 
 #include <Realm.h>
+#include <ElemGeometryCache.h>
 #include <FieldTypeDef.h>
 #include <master_element/MasterElement.h>
+#include <KokkosInterface.h>
+#include <utils/StkHelpers.h>
 
 // stk_mesh/base/fem
 #include <stk_mesh/base/BulkData.hpp>
@@ -20,9 +23,19 @@
 // stk_topo
 #include <stk_topology/topology.hpp>
 
+#include <stk_util/util/ReportHandler.hpp>
+
 // basic c++
 #include <vector>
 
+namespace {
+// upper bounds for the per-element scratch arrays (Hex27 CVFEM)
+constexpr int maxNodesPerElement = 27;
+constexpr int maxScvIp = 216;
+constexpr int maxScsIp = 216;
+constexpr int maxDim = 3;
+}
+
 //==========================================================================
 // Class Definition
 //==========================================================================
@@ -54,6 +67,9 @@ ComputeGeometryInteriorAlgorithm::execute()
   // extract field always germane
   ScalarFieldType *dualNodalVolume = meta_data.get_field<ScalarFieldType>(stk::topology::NODE_RANK, "dual_nodal_volume");
   VectorFieldType *coordinates = meta_data.get_field<VectorFieldType>(stk::topology::NODE_RANK, realm_.get_coordinates_name());
+
+  // scv volumes are already available when the element geometry cache is active
+  const ElemGeometryCache *geomCache = realm_.elemGeometryCache_;
  
   // setup for buckets; union parts and ask for locally owned
   stk::mesh::Selector s_locally_owned_union = meta_data.locally_owned_part()
@@ -63,6 +79,10 @@ ComputeGeometryInteriorAlgorithm::execute()
   stk::mesh::BucketVector const& element_buckets =
     realm_.get_buckets( stk::topology::ELEMENT_RANK, s_locally_owned_union );
 
+  // bucket geometry of the batched master element path
+  std::vector<double> ws_bucket_coordinates;
+  std::vector<double> ws_bucket_scv_volume;
+
   //===========================================================
   // nodal volume assembly
   //===========================================================
@@ -77,13 +97,24 @@ ComputeGeometryInteriorAlgorithm::execute()
     const int nodesPerElement = meSCV->nodesPerElement_;
     const int numScvIp = meSCV->numIntPoints_;
     const int *ipNodeMap = meSCV->ipNodeMap();
-
-    // define scratch field
-    std::vector<double > ws_coordinates(nodesPerElement*nDim);
-    std::vector<double > ws_scv_volume(numScvIp);
+    ThrowRequire(nodesPerElement <= maxNodesPerElement && numScvIp <= maxScvIp && nDim <= maxDim);
 
     const stk::mesh::Bucket::size_type length   = b.size();
-    for ( stk::mesh::Bucket::size_type k = 0 ; k < length ; ++k ) {
+
+    // linear tets: subcontrol volumes of the whole bucket in one call
+    const double * p_bucket_scv_volume = NULL;
+    if ( meSCV->has_batch_eval() && NULL == geomCache ) {
+      gather_bucket_coordinates(b, *coordinates, nDim, ws_bucket_coordinates);
+      ws_bucket_scv_volume.resize(length*numScvIp);
+      meSCV->batch_determinant(length, &ws_bucket_coordinates[0], &ws_bucket_scv_volume[0]);
+      p_bucket_scv_volume = &ws_bucket_scv_volume[0];
+    }
+
+    kokkos_parallel_for("ComputeGeometryInteriorAlgorithm::execute", length, [&] (const stk::mesh::Bucket::size_type& k) {
+
+      // define scratch field; per element so that the loop can be threaded
+      double ws_coordinates[maxNodesPerElement*maxDim];
+      double ws_scv_volume[maxScvIp];
 
       //===============================================
       // gather nodal data; this is how we do it now..
@@ -94,18 +125,24 @@ ComputeGeometryInteriorAlgorithm::execute()
       // sanity check on num nodes
       ThrowAssert( num_nodes == nodesPerElement );
 
-      for ( int ni = 0; ni < num_nodes; ++ni ) {
-        stk::mesh::Entity node = node_rels[ni];
-        double * coords = stk::mesh::field_data(*coordinates, node);
-        const int offSet = ni*nDim;
-        for ( int j=0; j < nDim; ++j ) {
-          ws_coordinates[offSet+j] = coords[j];
+      const double * p_scv_volume = (NULL != geomCache) ? geomCache->scv_volume(b[k]) : NULL;
+      if ( NULL == p_scv_volume && NULL != p_bucket_scv_volume )
+        p_scv_volume = p_bucket_scv_volume + k*numScvIp;
+      if ( NULL == p_scv_volume ) {
+        for ( int ni = 0; ni < num_nodes; ++ni ) {
+          stk::mesh::Entity node = node_rels[ni];
+          double * coords = stk::mesh::field_data(*coordinates, node);
+          const int offSet = ni*nDim;
+          for ( int j=0; j < nDim; ++j ) {
+            ws_coordinates[offSet+j] = coords[j];
+          }
         }
-      }
 
-      // compute integration point volume
-      double scv_error = 0.0;
-      meSCV->determinant(1, &ws_coordinates[0], &ws_scv_volume[0], &scv_error);
+        // compute integration point volume
+        double scv_error = 0.0;
+        meSCV->determinant(1, &ws_coordinates[0], &ws_scv_volume[0], &scv_error);
+        p_scv_volume = ws_scv_volume;
+      }
 
       // assemble dual volume while scattering ip volume
       for ( int ip = 0; ip < numScvIp; ++ip ) {
@@ -113,10 +150,109 @@ ComputeGeometryInteriorAlgorithm::execute()
         const int nn = ipNodeMap[ip];
         stk::mesh::Entity node = node_rels[nn];
         double * dualcv = stk::mesh::field_data(*dualNodalVolume, node);
-        // augment nodal dual volume
-        *dualcv += ws_scv_volume[ip];
+        // augment nodal dual volume; node is shared with neighbouring elements
+        Kokkos::atomic_add(dualcv, p_scv_volume[ip]);
       }
+    });
+  }
+
+  //===========================================================
+  // edge area vector assembly
+  //===========================================================
+  if ( realm_.realmUsesEdges_ )
+    assemble_edge_area_vector();
+}
+
+//--------------------------------------------------------------------------
+//-------- assemble_edge_area_vector ---------------------------------------
+//--------------------------------------------------------------------------
+void
+ComputeGeometryInteriorAlgorithm::assemble_edge_area_vector()
+{
+  stk::mesh::BulkData & bulk_data = realm_.bulk_data();
+  stk::mesh::MetaData & meta_data = realm_.meta_data();
+
+  const int nDim = meta_data.spatial_dimension();
+
+  VectorFieldType *coordinates = meta_data.get_field<VectorFieldType>(stk::topology::NODE_RANK, realm_.get_coordinates_name());
+  VectorFieldType *edgeAreaVec = meta_data.get_field<VectorFieldType>(stk::topology::EDGE_RANK, "edge_area_vector");
+  ThrowRequireMsg(NULL != edgeAreaVec, "ComputeGeometryInteriorAlgorithm: edge_area_vector is not registered");
+
+  const ElemGeometryCache *geomCache = realm_.elemGeometryCache_;
+
+  std::vector<double> ws_bucket_coordinates;
+  std::vector<double> ws_bucket_scs_areav;
+
+  stk::mesh::Selector s_locally_owned_union = meta_data.locally_owned_part()
+    & stk::mesh::selectUnion(partVec_)
+    & !(realm_.get_inactive_selector());
+
+  stk::mesh::BucketVector const& element_buckets =
+    realm_.get_buckets( stk::topology::ELEMENT_RANK, s_locally_owned_union );
+
+  for ( stk::mesh::BucketVector::const_iterator ib = element_buckets.begin();
+        ib != element_buckets.end() ; ++ib ) {
+    stk::mesh::Bucket & b = **ib ;
+
+    // extract master element; for linear tets and triangles every scs belongs to one edge
+    MasterElement *meSCS = MasterElementRepo::get_surface_master_element(b.topology());
+
+    const int nodesPerElement = meSCS->nodesPerElement_;
+    const int numScsIp = meSCS->numIntPoints_;
+    const int *lrscv = meSCS->adjacentNodes();
+    const int *scsIpEdgeOrd = meSCS->scsIpEdgeOrd();
+    ThrowRequire(nodesPerElement <= maxNodesPerElement && numScsIp <= maxScsIp && nDim <= maxDim);
+
+    const stk::mesh::Bucket::size_type length   = b.size();
+
+    const double * p_bucket_scs_areav = NULL;
+    if ( meSCS->has_batch_eval() && NULL == geomCache ) {
+      gather_bucket_coordinates(b, *coordinates, nDim, ws_bucket_coordinates);
+      ws_bucket_scs_areav.resize(length*numScsIp*nDim);
+      meSCS->batch_determinant(length, &ws_bucket_coordinates[0], &ws_bucket_scs_areav[0]);
+      p_bucket_scs_areav = &ws_bucket_scs_areav[0];
     }
+
+    kokkos_parallel_for("ComputeGeometryInteriorAlgorithm::assemble_edge_area_vector", length, [&] (const stk::mesh::Bucket::size_type& k) {
+
+      double ws_coordinates[maxNodesPerElement*maxDim];
+      double ws_scs_areav[maxScsIp*maxDim];
+
+      stk::mesh::Entity elem = b[k];
+      stk::mesh::Entity const * node_rels = b.begin_nodes(k);
+      stk::mesh::Entity const * edge_rels = bulk_data.begin_edges(elem);
+
+      // sanity check on num edges
+      ThrowAssert( bulk_data.num_edges(elem) > 0 );
+
+      const double * p_scs_areav = (NULL != geomCache) ? geomCache->scs_areav(elem) : NULL;
+      if ( NULL == p_scs_areav && NULL != p_bucket_scs_areav )
+        p_scs_areav = p_bucket_scs_areav + k*numScsIp*nDim;
+      if ( NULL == p_scs_areav ) {
+        for ( int ni = 0; ni < nodesPerElement; ++ni ) {
+          const double * coords = stk::mesh::field_data(*coordinates, node_rels[ni]);
+          for ( int j=0; j < nDim; ++j ) {
+            ws_coordinates[ni*nDim+j] = coords[j];
+          }
+        }
+
+        double scs_error = 0.0;
+        meSCS->determinant(1, &ws_coordinates[0], &ws_scs_areav[0], &scs_error);
+        p_scs_areav = ws_scs_areav;
+      }
+
+      for ( int ip = 0; ip < numScsIp; ++ip ) {
+        // area vector points from the left to the right node of the ip; orient it along the edge
+        stk::mesh::Entity edge = edge_rels[scsIpEdgeOrd[ip]];
+        stk::mesh::Entity const * edge_node_rels = bulk_data.begin_nodes(edge);
+        const double sign = ( node_rels[lrscv[2*ip]] == edge_node_rels[0] ) ? 1.0 : -1.0;
+
+        // edge is shared with neighbouring elements
+        double * av = stk::mesh::field_data(*edgeAreaVec, edge);
+        for ( int j=0; j < nDim; ++j )
+          Kokkos::atomic_add(&av[j], sign*p_scs_areav[ip*nDim+j]);
+      }
+    });
   }
 }
 
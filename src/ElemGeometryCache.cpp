@@ -0,0 +1,193 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "ElemGeometryCache.h"
+
+#include <Realm.h>
+#include <HOFlowEnv.h>
+#include <FieldTypeDef.h>
+#include <master_element/MasterElement.h>
+
+// stk_mesh/base/fem
+#include <stk_mesh/base/BulkData.hpp>
+#include <stk_mesh/base/Field.hpp>
+#include <stk_mesh/base/GetBuckets.hpp>
+#include <stk_mesh/base/MetaData.hpp>
+#include <stk_mesh/base/Part.hpp>
+
+#include <stk_util/util/ReportHandler.hpp>
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// ElemGeometryCache - stores scs_areav, dndx and scv_volume per element
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+ElemGeometryCache::ElemGeometryCache(Realm & realm) :
+    timerBuild_(0.0),
+    realm_(realm),
+    isValid_(false)
+{
+    // nothing to do
+}
+
+//--------------------------------------------------------------------------
+//-------- destructor ------------------------------------------------------
+//--------------------------------------------------------------------------
+ElemGeometryCache::~ElemGeometryCache()
+{
+    // nothing to do
+}
+
+//--------------------------------------------------------------------------
+//-------- build -----------------------------------------------------------
+//--------------------------------------------------------------------------
+void ElemGeometryCache::build() {
+    double time = -HOFlowEnv::self().hoflow_time();
+
+    invalidate();
+
+    stk::mesh::BulkData & bulk_data = realm_.bulk_data();
+    stk::mesh::MetaData & meta_data = realm_.meta_data();
+
+    const int nDim = meta_data.spatial_dimension();
+    VectorFieldType * coordinates = meta_data.get_field<VectorFieldType>(stk::topology::NODE_RANK, realm_.get_coordinates_name());
+
+    // same elements as the interior assembly and geometry algorithms
+    stk::mesh::Selector s_locally_owned_union = meta_data.locally_owned_part()
+        & stk::mesh::selectUnion(realm_.interiorPartVec_)
+        & !(realm_.get_inactive_selector());
+
+    stk::mesh::BucketVector const & elem_buckets = realm_.get_buckets( stk::topology::ELEMENT_RANK, s_locally_owned_union );
+
+    // first pass; hand out contiguous slots, bucket by bucket
+    const size_t invalidSlot = INVALID_SLOT;
+    elemSlot_.assign(bulk_data.get_size_of_entity_index_space(), invalidSlot);
+
+    size_t sizeAreav = 0;
+    size_t sizeDndx = 0;
+    size_t sizeScv = 0;
+    for ( stk::mesh::BucketVector::const_iterator ib = elem_buckets.begin(); ib != elem_buckets.end() ; ++ib ) {
+        stk::mesh::Bucket & b = **ib;
+        MasterElement * meSCS = MasterElementRepo::get_surface_master_element(b.topology());
+        MasterElement * meSCV = MasterElementRepo::get_volume_master_element(b.topology());
+
+        const size_t strideAreav = meSCS->numIntPoints_*nDim;
+        const size_t strideDndx = meSCS->numIntPoints_*meSCS->nodesPerElement_*nDim;
+        const size_t strideScv = meSCV->numIntPoints_;
+
+        for ( size_t k = 0; k < b.size(); ++k ) {
+            elemSlot_[b[k].local_offset()] = offsets_.size();
+            ElemOffsets off = { sizeAreav, sizeDndx, sizeScv };
+            offsets_.push_back(off);
+            sizeAreav += strideAreav;
+            sizeDndx += strideDndx;
+            sizeScv += strideScv;
+        }
+    }
+
+    scsAreav_.resize(sizeAreav);
+    dndx_.resize(sizeDndx);
+    scvVolume_.resize(sizeScv);
+
+    // second pass; compute the geometry straight into the slots
+    std::vector<double> ws_coordinates;
+    std::vector<double> ws_deriv;
+    std::vector<double> ws_det_j;
+    for ( stk::mesh::BucketVector::const_iterator ib = elem_buckets.begin(); ib != elem_buckets.end() ; ++ib ) {
+        stk::mesh::Bucket & b = **ib;
+        MasterElement * meSCS = MasterElementRepo::get_surface_master_element(b.topology());
+        MasterElement * meSCV = MasterElementRepo::get_volume_master_element(b.topology());
+
+        const int nodesPerElement = meSCS->nodesPerElement_;
+        const int numScsIp = meSCS->numIntPoints_;
+
+        ws_coordinates.resize(nodesPerElement*nDim);
+        ws_deriv.resize(nDim*numScsIp*nodesPerElement);
+        ws_det_j.resize(numScsIp);
+
+        for ( size_t k = 0; k < b.size(); ++k ) {
+            stk::mesh::Entity const * node_rels = b.begin_nodes(k);
+            const int num_nodes = b.num_nodes(k);
+
+            // sanity check on num nodes
+            ThrowAssert( num_nodes == nodesPerElement );
+
+            for ( int ni = 0; ni < num_nodes; ++ni ) {
+                const double * coords = stk::mesh::field_data(*coordinates, node_rels[ni]);
+                for ( int j = 0; j < nDim; ++j )
+                    ws_coordinates[ni*nDim+j] = coords[j];
+            }
+
+            const ElemOffsets & off = offsets_[elemSlot_[b[k].local_offset()]];
+
+            double error = 0.0;
+            meSCS->determinant(1, &ws_coordinates[0], &scsAreav_[off.areav_], &error);
+            meSCS->grad_op(1, &ws_coordinates[0], &dndx_[off.dndx_], &ws_deriv[0], &ws_det_j[0], &error);
+            meSCV->determinant(1, &ws_coordinates[0], &scvVolume_[off.scv_], &error);
+        }
+    }
+
+    isValid_ = true;
+
+    time += HOFlowEnv::self().hoflow_time();
+    timerBuild_ += time;
+}
+
+//--------------------------------------------------------------------------
+//-------- invalidate ------------------------------------------------------
+//--------------------------------------------------------------------------
+void ElemGeometryCache::invalidate() {
+    // swap with empty vectors so that the memory is actually released
+    std::vector<size_t>().swap(elemSlot_);
+    std::vector<ElemOffsets>().swap(offsets_);
+    std::vector<double>().swap(scsAreav_);
+    std::vector<double>().swap(dndx_);
+    std::vector<double>().swap(scvVolume_);
+    isValid_ = false;
+}
+
+//--------------------------------------------------------------------------
+//-------- slot ------------------------------------------------------------
+//--------------------------------------------------------------------------
+size_t ElemGeometryCache::slot(stk::mesh::Entity elem) const {
+    if ( !isValid_ || elem.local_offset() >= elemSlot_.size() )
+        return INVALID_SLOT;
+    return elemSlot_[elem.local_offset()];
+}
+
+//--------------------------------------------------------------------------
+//-------- scs_areav -------------------------------------------------------
+//--------------------------------------------------------------------------
+const double * ElemGeometryCache::scs_areav(stk::mesh::Entity elem) const {
+    const size_t s = slot(elem);
+    return s == INVALID_SLOT ? NULL : &scsAreav_[offsets_[s].areav_];
+}
+
+//--------------------------------------------------------------------------
+//-------- dndx ------------------------------------------------------------
+//--------------------------------------------------------------------------
+const double * ElemGeometryCache::dndx(stk::mesh::Entity elem) const {
+    const size_t s = slot(elem);
+    return s == INVALID_SLOT ? NULL : &dndx_[offsets_[s].dndx_];
+}
+
+//--------------------------------------------------------------------------
+//-------- scv_volume ------------------------------------------------------
+//--------------------------------------------------------------------------
+const double * ElemGeometryCache::scv_volume(stk::mesh::Entity elem) const {
+    const size_t s = slot(elem);
+    return s == INVALID_SLOT ? NULL : &scvVolume_[offsets_[s].scv_];
+}
+
+//--------------------------------------------------------------------------
+//-------- memory_bytes ----------------------------------------------------
+//--------------------------------------------------------------------------
+size_t ElemGeometryCache::memory_bytes() const {
+    return elemSlot_.capacity()*sizeof(size_t)
+        + offsets_.capacity()*sizeof(ElemOffsets)
+        + (scsAreav_.capacity() + dndx_.capacity() + scvVolume_.capacity())*sizeof(double);
+}
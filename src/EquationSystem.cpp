@@ -40,6 +40,10 @@ EquationSystem::EquationSystem(EquationSystems & eqSystems, const std::string na
     maxLinearIterations_(0.0),
     minLinearIterations_(1.0e10),
     nonLinearIterationCount_(0),
+    numPrecondComputes_(0),
+    avgInitialGuessResidual_(0.0),
+    maxInitialGuessResidual_(0.0),
+    initialGuessCount_(0),
     reportLinearIterations_(false),
     firstTimeStepSolve_(true),
     edgeNodalGradient_(false),
@@ -119,7 +123,10 @@ void EquationSystem::assemble_and_solve(stk::mesh::FieldBase *deltaSolution) {
 
     // apply all flux and dirichlet algs
     timeA = HOFlowEnv::self().hoflow_time();
-    solverAlgDriver_->execute();
+    if ( realm_.solutionOptions_->overlapSharedExport_ )
+        solverAlgDriver_->execute_overlapped(*linsys_);
+    else
+        solverAlgDriver_->execute();
     timeB = HOFlowEnv::self().hoflow_time();
     timerAssemble_ += (timeB-timeA);
 
@@ -135,9 +142,13 @@ void EquationSystem::assemble_and_solve(stk::mesh::FieldBase *deltaSolution) {
     timeB = HOFlowEnv::self().hoflow_time();
     timerSolve_ += (timeB-timeA);
     timerPrecond_ += linsys_->get_timer_precond();
+    if ( linsys_->get_precond_computed() )
+        numPrecondComputes_ += 1;
 
     // handle statistics
     update_iteration_statistics(linsys_->linearSolveIterations());
+    if ( linsys_->initialGuessActive() )
+        update_initial_guess_statistics(linsys_->initialGuessResidual());
 
     if ( error > 0 )
         HOFlowEnv::self().hoflowOutputP0() << "Error in " << userSuppliedName_ << "::solve_and_update()  " << std::endl;
@@ -283,7 +294,13 @@ void EquationSystem::dump_eq_time() {
     if (reportLinearIterations_)
         HOFlowEnv::self().hoflowOutputP0() << "linear iterations -- " << " \tavg: " << avgLinearIterations_
                         << " \tmin: " << minLinearIterations_ << " \tmax: "
-                        << maxLinearIterations_ << std::endl;
+                        << maxLinearIterations_ << " \tprecond computes: "
+                        << numPrecondComputes_ << "/" << nonLinearIterationCount_ << std::endl;
+
+    // quality of the Krylov initial guess; the zero guess has a ratio of 1
+    if (initialGuessCount_ > 0)
+        HOFlowEnv::self().hoflowOutputP0() << "    initial guess -- " << " \tavg |b-Ax0|/|b|: " << avgInitialGuessResidual_
+                        << " \tmax: " << maxInitialGuessResidual_ << std::endl;
 
     // reset anytime these are called; 
     // some EquationSystems have no linear system, e.g., LowMach holds .. uvw_p
@@ -299,6 +316,10 @@ void EquationSystem::dump_eq_time() {
     minLinearIterations_ = 1.0e10;
     maxLinearIterations_ = 0.0;
     nonLinearIterationCount_ = 0;
+    numPrecondComputes_ = 0;
+    avgInitialGuessResidual_ = 0.0;
+    maxInitialGuessResidual_ = 0.0;
+    initialGuessCount_ = 0;
 }
 
 void EquationSystem::update_iteration_statistics(const int & iters) {
@@ -311,6 +332,13 @@ void EquationSystem::update_iteration_statistics(const int & iters) {
     reportLinearIterations_ = true;
 }
 
+void EquationSystem::update_initial_guess_statistics(const double & residualRatio) {
+    avgInitialGuessResidual_ = (initialGuessCount_*avgInitialGuessResidual_
+                                + residualRatio)/(initialGuessCount_+1);
+    maxInitialGuessResidual_ = std::max(maxInitialGuessResidual_,residualRatio);
+    initialGuessCount_ += 1;
+}
+
 bool EquationSystem::bc_data_specified(const UserData &userData, std::string &name) {
     bool isSpecified = false;
     std::map<std::string, bool>::const_iterator iter = userData.bcDataSpecifiedMap_.find(name);
@@ -7,7 +7,7 @@
 #include "AssembleElemSolverAlgorithm.h"
 //#include "AssembleHeatCondWallSolverAlgorithm.h"
 //#include "AssembleHeatCondIrradWallSolverAlgorithm.h"
-//#include "AssembleScalarEdgeDiffSolverAlgorithm.h"
+#include "AssembleScalarEdgeDiffSolverAlgorithm.h"
 #include "AssembleScalarElemDiffSolverAlgorithm.h"
 //#include "AssembleScalarDiffNonConformalSolverAlgorithm.h"
 #include "AssembleScalarFluxBCSolverAlgorithm.h"
@@ -17,6 +17,7 @@
 #include "AssembleNodalGradBoundaryAlgorithm.h"
 //#include "AssembleNodalGradNonConformalAlgorithm.h"
 #include "AssembleNodeSolverAlgorithm.h"
+#include "AssembleHeatCondMassBucketAlgorithm.h"
 #include "AuxFunctionAlgorithm.h"
 #include "ConstantAuxFunction.h"
 #include "CopyFieldAlgorithm.h"
@@ -29,12 +30,13 @@
 #include "LinearSolvers.h"
 #include "LinearSolver.h"
 #include "LinearSystem.h"
+#include "MaterialProperty.h"
+#include "MaterialPropertyData.h"
 #include "master_element/MasterElement.h"
 #include "HOFlowEnv.h"
 #include "Realm.h"
 #include "Realms.h"
-#include "HeatCondMassBackwardEulerNodeSuppAlg.h"
-#include "HeatCondMassBDF2NodeSuppAlg.h"
+#include "HeatCondMatrixFreeOperator.h"
 #include "ProjectedNodalGradientEquationSystem.h"
 //#include "PstabErrorIndicatorEdgeAlgorithm.h"
 //#include "PstabErrorIndicatorElemAlgorithm.h"
@@ -49,6 +51,9 @@
 #include "kernel/KernelBuilder.h"
 #include "kernel/KernelBuilderLog.h"
 
+// consolidated kernels
+#include "kernel/ScalarDiffElemKernel.h"
+
 // HOFlow utils
 #include "utils/StkHelpers.h"
 
@@ -90,8 +95,12 @@ HeatCondEquationSystem::HeatCondEquationSystem(EquationSystems & eqSystems) :
     thermalCond_(NULL),
     edgeAreaVec_(NULL),
     assembleNodalGradAlgDriver_(new AssembleNodalGradAlgorithmDriver(realm_, "temperature", "dtdx")),
+    fusedDiffAlg_(NULL),
     isInit_(true),
-    projectedNodalGradEqs_(NULL)
+    projectedNodalGradEqs_(NULL),
+    lhsTimeStep_(0.0),
+    lhsGamma1_(0.0),
+    constantLhsReported_(false)
 {
     // extract solver name and solver object
     std::string solverName = realm_.equationSystems_.get_solver_block_name("temperature");
@@ -177,7 +186,12 @@ void HeatCondEquationSystem::register_nodal_fields(stk::mesh::Part *part) {
 }
 
 void HeatCondEquationSystem::register_edge_fields(stk::mesh::Part *part) {
-    // can be deleted but safely
+    if ( realm_.realmUsesEdges_ ) {
+        stk::mesh::MetaData & meta_data = realm_.meta_data();
+        const int nDim = meta_data.spatial_dimension();
+        edgeAreaVec_ = &(meta_data.declare_field<VectorFieldType>(stk::topology::EDGE_RANK, "edge_area_vector"));
+        stk::mesh::put_field_on_mesh(*edgeAreaVec_, *part, nDim, nullptr);
+    }
 }
 
 void HeatCondEquationSystem::register_element_fields(stk::mesh::Part * part, const stk::topology & theTopo) {
@@ -207,17 +221,39 @@ void HeatCondEquationSystem::register_interior_algorithm(stk::mesh::Part *part)
     }
 
     // solver; interior edge/element contribution (diffusion)
-    if (!realm_.solutionOptions_->useConsolidatedSolverAlg_) {
+    if ( realm_.realmUsesEdges_ ) {
+        // edge area vectors are only complete for elements whose scs each lie on one edge
+        const stk::topology partTopo = part->topology();
+        if ( partTopo != stk::topology::TET_4 && partTopo != stk::topology::TRIANGLE_3_2D )
+            throw std::runtime_error("HeatCondEquationSystem: use_edges requires Tet4 or Tri3 elements, part "
+                                     + part->name() + " is " + partTopo.name());
+
+        std::map<AlgorithmType, SolverAlgorithm *>::iterator itsi = solverAlgDriver_->solverAlgMap_.find(algType);
+        if ( itsi == solverAlgDriver_->solverAlgMap_.end() ) {
+            SolverAlgorithm * theSolverAlg = new AssembleScalarEdgeDiffSolverAlgorithm(realm_, part, this, &tempNp1, &dtdxNone, thermalCond_);
+            solverAlgDriver_->solverAlgMap_[algType] = theSolverAlg;
+        }
+        else {
+            itsi->second->partVec_.push_back(part);
+        }
+    }
+    else if (!realm_.solutionOptions_->useConsolidatedSolverAlg_) {
         // Not consolidated solver algorithm
         
         std::map<AlgorithmType, SolverAlgorithm *>::iterator itsi = solverAlgDriver_->solverAlgMap_.find(algType);
         
         // If algorithm is not present, create a new one
         if ( itsi == solverAlgDriver_->solverAlgMap_.end() ) {
-            SolverAlgorithm * theSolverAlg = NULL;
+            AssembleScalarElemDiffSolverAlgorithm * theSolverAlg = NULL;
             theSolverAlg = new AssembleScalarElemDiffSolverAlgorithm(realm_, part, this, &tempNp1, &dtdxNone, thermalCond_);
             solverAlgDriver_->solverAlgMap_[algType] = theSolverAlg;
 
+            // the same element sweep can provide the Green-Gauss dtdx; not for a projected nodal gradient
+            if ( realm_.solutionOptions_->fuseNodalGradient_ && !managePNG_ ) {
+                theSolverAlg->useShiftedNodalGradient_ = edgeNodalGradient_;
+                fusedDiffAlg_ = theSolverAlg;
+            }
+
 //            // look for fully integrated source terms
 //            std::map<std::string, std::vector<std::string> >::iterator isrc  = realm_.solutionOptions_->elemSrcTermsMap_.find("temperature");
 //            if ( isrc != realm_.solutionOptions_->elemSrcTermsMap_.end() ) {
@@ -269,19 +305,19 @@ void HeatCondEquationSystem::register_interior_algorithm(stk::mesh::Part *part)
 //            realm_.bulk_data(), *realm_.solutionOptions_, dataPreReqs
 //          );
 //
-//          build_topo_kernel_if_requested<ScalarDiffElemKernel>(
-//            partTopo, *this, activeKernels, "CVFEM_DIFF",
-//            realm_.bulk_data(), *realm_.solutionOptions_,
-//            temperature_, thermalCond_, dataPreReqs
-//          );
-//
+          build_topo_kernel_if_requested<ScalarDiffElemKernel>(
+            partTopo, *this, activeKernels, "CVFEM_DIFF",
+            realm_.bulk_data(), *realm_.solutionOptions_,
+            &tempNp1, thermalCond_, dataPreReqs
+          );
+
 //          build_fem_kernel_if_requested<ScalarDiffFemKernel>(
 //            partTopo, *this, activeKernels, "FEM_DIFF",
 //            realm_.bulk_data(), *realm_.solutionOptions_, temperature_, thermalCond_, dataPreReqs
 //          );
-//
-//          report_invalid_supp_alg_names();
-//          report_built_supp_alg_names();
+
+          report_invalid_supp_alg_names();
+          report_built_supp_alg_names();
         }
     }
 
@@ -291,22 +327,17 @@ void HeatCondEquationSystem::register_interior_algorithm(stk::mesh::Part *part)
     
     // If algorithm is not present, create a new one
     if ( itsm == solverAlgDriver_->solverAlgMap_.end() ) {
-        // create the solver alg
-        AssembleNodeSolverAlgorithm * theAlg = new AssembleNodeSolverAlgorithm(realm_, part, this);
-        solverAlgDriver_->solverAlgMap_[algMass] = theAlg;
-
         if (realm_.simType_ == "transient") {
-            // now create the supplemental alg for mass term
-            if ( realm_.number_of_states() == 2 ) {
-                // 1st order time accuracy, bdf1 = backwards euler aka implicit euler
-                HeatCondMassBackwardEulerNodeSuppAlg * theMass = new HeatCondMassBackwardEulerNodeSuppAlg(realm_);
-                theAlg->supplementalAlg_.push_back(theMass);
-            }
-            else {
-                // 2nd order time accuracy, backward differentiation formula bdf2
-                HeatCondMassBDF2NodeSuppAlg * theMass = new HeatCondMassBDF2NodeSuppAlg(realm_);
-                theAlg->supplementalAlg_.push_back(theMass);
-            }
+            // mass term bucket by bucket straight into the diagonal; bdf1 (backward euler) with
+            // two states, bdf2 otherwise
+            const bool useBDF2 = realm_.number_of_states() != 2;
+            AssembleHeatCondMassBucketAlgorithm * theAlg = new AssembleHeatCondMassBucketAlgorithm(realm_, part, this, useBDF2);
+            solverAlgDriver_->solverAlgMap_[algMass] = theAlg;
+        }
+        else {
+            // create the solver alg
+            AssembleNodeSolverAlgorithm * theAlg = new AssembleNodeSolverAlgorithm(realm_, part, this);
+            solverAlgDriver_->solverAlgMap_[algMass] = theAlg;
         }
 
 //        // Add src term supp alg...; limited number supported
@@ -685,6 +716,10 @@ void HeatCondEquationSystem::initialize() {
 }
 
 void HeatCondEquationSystem::reinitialize_linear_system() {
+    // the graph, maps and solver only depend on the mesh; keep them if it was not modified
+    if ( NULL != linsys_ && linsys_->mesh_unchanged() )
+        return;
+
     // delete linsys
     delete linsys_;
 
@@ -708,6 +743,13 @@ void HeatCondEquationSystem::reinitialize_linear_system() {
     linsys_->finalizeLinearSystem();
 }
 
+MatrixFreeOperator * HeatCondEquationSystem::create_matrix_free_operator(const TpetraLinearSystem & linsys) {
+    // the operator applies the element stencil; it does not match the edge-based matrix
+    if ( realm_.realmUsesEdges_ )
+        return NULL;
+    return new HeatCondMatrixFreeOperator(realm_, linsys, thermalCond_, realm_.get_shifted_grad_op("temperature"));
+}
+
 void HeatCondEquationSystem::predict_state() {
     // copy state n to state np1
     ScalarFieldType & tN = temperature_->field_of_state(stk::mesh::StateN);
@@ -727,9 +769,24 @@ void HeatCondEquationSystem::solve_and_update() {
         HOFlowEnv::self().hoflowOutputP0() << " " << k+1 << "/" << maxIterations_
                                            << std::setw(15) << std::right << userSuppliedName_ << std::endl;
 
+        // after the first iteration the assembly sweep recomputes dtdx of the current iterate
+        const bool fuseNodalGradient = (NULL != fusedDiffAlg_) && (k > 0);
+        if ( fuseNodalGradient ) {
+            assembleNodalGradAlgDriver_->pre_work();
+            fusedDiffAlg_->computeNodalGradient_ = true;
+        }
+
         // heat conduction assemble, load_complete and solve for tTmp (delta solution)
+        linsys_->reuse_lhs(lhs_is_unchanged());
         assemble_and_solve(tTmp_);
 
+        if ( fuseNodalGradient ) {
+            fusedDiffAlg_->computeNodalGradient_ = false;
+            const double timeGrad = HOFlowEnv::self().hoflow_time();
+            complete_fused_nodal_gradient();
+            timerMisc_ += (HOFlowEnv::self().hoflow_time() - timeGrad);
+        }
+
         // update
         double timeA = HOFlowEnv::self().hoflow_time();
         
@@ -743,14 +800,54 @@ void HeatCondEquationSystem::solve_and_update() {
         double timeB = HOFlowEnv::self().hoflow_time();
         timerAssemble_ += (timeB-timeA);
 
-        // projected nodal gradient
-        timeA = HOFlowEnv::self().hoflow_time();
-        compute_projected_nodal_gradient();
-        timeB = HOFlowEnv::self().hoflow_time();
-        timerMisc_ += (timeB-timeA);
+        // projected nodal gradient; when fused, the next assembly provides it
+        if ( NULL == fusedDiffAlg_ || k == maxIterations_-1 ) {
+            timeA = HOFlowEnv::self().hoflow_time();
+            compute_projected_nodal_gradient();
+            timeB = HOFlowEnv::self().hoflow_time();
+            timerMisc_ += (timeB-timeA);
+        }
     }  
 }
 
+bool HeatCondEquationSystem::lhs_is_unchanged() {
+    if ( !realm_.solutionOptions_->reuseConstantLhs_ || realm_.solutionOptions_->does_mesh_move() )
+        return false;
+
+    // only constant properties give a constant conductivity and mass term
+    for ( size_t i = 0; i < realm_.materialProperties_.size(); ++i ) {
+        const MaterialProperty * matProp = realm_.materialProperties_[i];
+        std::map<PropertyIdentifier, MaterialPropertyData *>::const_iterator ii;
+        for ( ii = matProp->propertyDataMap_.begin(); ii != matProp->propertyDataMap_.end(); ++ii ) {
+            if ( (*ii).second->type_ != CONSTANT_MAT )
+                return false;
+        }
+    }
+
+    // the mass term scales with 1/dt
+    const double dt = realm_.get_time_step();
+    const double gamma1 = realm_.get_gamma1();
+    const bool unchanged = (dt == lhsTimeStep_) && (gamma1 == lhsGamma1_);
+    lhsTimeStep_ = dt;
+    lhsGamma1_ = gamma1;
+
+    if ( unchanged && !constantLhsReported_ ) {
+        HOFlowEnv::self().hoflowOutputP0() << userSuppliedName_ << ": constant LHS, assembling the RHS only" << std::endl;
+        constantLhsReported_ = true;
+    }
+    return unchanged;
+}
+
+void HeatCondEquationSystem::complete_fused_nodal_gradient() {
+    // the interior part was assembled by fusedDiffAlg_
+    std::map<AlgorithmType, Algorithm *>::iterator it;
+    for ( it = assembleNodalGradAlgDriver_->algMap_.begin(); it != assembleNodalGradAlgDriver_->algMap_.end(); ++it ) {
+        if ( it->first != INTERIOR )
+            it->second->execute();
+    }
+    assembleNodalGradAlgDriver_->post_work();
+}
+
 void HeatCondEquationSystem::compute_projected_nodal_gradient() {
     if ( !managePNG_ ) {
         assembleNodalGradAlgDriver_->execute();
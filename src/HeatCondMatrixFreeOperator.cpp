@@ -0,0 +1,170 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "HeatCondMatrixFreeOperator.h"
+
+#include <Realm.h>
+#include <ElemGeometryCache.h>
+#include <master_element/MasterElement.h>
+
+// stk_mesh/base/fem
+#include <stk_mesh/base/BulkData.hpp>
+#include <stk_mesh/base/Field.hpp>
+#include <stk_mesh/base/GetBuckets.hpp>
+#include <stk_mesh/base/MetaData.hpp>
+#include <stk_mesh/base/Part.hpp>
+
+#include <stk_util/util/ReportHandler.hpp>
+
+#include <vector>
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// HeatCondMatrixFreeOperator - element-by-element CVFEM diffusion
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+HeatCondMatrixFreeOperator::HeatCondMatrixFreeOperator(
+    Realm & realm,
+    const TpetraLinearSystem & linsys,
+    ScalarFieldType * thermalCond,
+    const bool shiftedGradOp) :
+        MatrixFreeOperator(linsys),
+        realm_(realm),
+        thermalCond_(thermalCond),
+        coordinates_(NULL),
+        shiftedGradOp_(shiftedGradOp)
+{
+    stk::mesh::MetaData & meta_data = realm_.meta_data();
+    coordinates_ = meta_data.get_field<VectorFieldType>(stk::topology::NODE_RANK, realm_.get_coordinates_name());
+}
+
+//--------------------------------------------------------------------------
+//-------- apply_off_diagonal ----------------------------------------------
+//--------------------------------------------------------------------------
+void HeatCondMatrixFreeOperator::apply_off_diagonal(const host_view_type & xCol,
+                                                    const host_view_type & yOwned,
+                                                    const host_view_type & ySharedNotOwned,
+                                                    const size_t vec) const {
+    stk::mesh::BulkData & bulk_data = realm_.bulk_data();
+    stk::mesh::MetaData & meta_data = realm_.meta_data();
+
+    const int nDim = meta_data.spatial_dimension();
+
+    // static geometry may come from the element cache; only the unshifted dndx is cached
+    const ElemGeometryCache * geomCache = realm_.elemGeometryCache_;
+    const bool useCachedDndx = (NULL != geomCache) && !shiftedGradOp_;
+
+    std::vector<double> ws_coordinates;
+    std::vector<double> ws_thermalCond;
+    std::vector<double> ws_scs_areav;
+    std::vector<double> ws_dndx;
+    std::vector<double> ws_deriv;
+    std::vector<double> ws_det_j;
+    std::vector<double> ws_shape_function;
+    std::vector<LinSys::LocalOrdinal> rowLids;
+    std::vector<double> xElem;
+
+    // same elements as the assembled diffusion algorithm
+    stk::mesh::Selector s_locally_owned_union = meta_data.locally_owned_part()
+        & stk::mesh::selectUnion(realm_.interiorPartVec_)
+        & !(realm_.get_inactive_selector());
+
+    stk::mesh::BucketVector const & elem_buckets = realm_.get_buckets( stk::topology::ELEMENT_RANK, s_locally_owned_union );
+    for ( stk::mesh::BucketVector::const_iterator ib = elem_buckets.begin(); ib != elem_buckets.end() ; ++ib ) {
+        stk::mesh::Bucket & b = **ib;
+        const stk::mesh::Bucket::size_type length = b.size();
+
+        // extract master element
+        MasterElement * meSCS = MasterElementRepo::get_surface_master_element(b.topology());
+
+        const int nodesPerElement = meSCS->nodesPerElement_;
+        const int numScsIp = meSCS->numIntPoints_;
+        const int * lrscv = meSCS->adjacentNodes();
+
+        ws_coordinates.resize(nodesPerElement*nDim);
+        ws_thermalCond.resize(nodesPerElement);
+        ws_scs_areav.resize(numScsIp*nDim);
+        ws_dndx.resize(nDim*numScsIp*nodesPerElement);
+        ws_deriv.resize(nDim*numScsIp*nodesPerElement);
+        ws_det_j.resize(numScsIp);
+        ws_shape_function.resize(numScsIp*nodesPerElement);
+        rowLids.resize(nodesPerElement);
+        xElem.resize(nodesPerElement);
+
+        meSCS->shape_fcn(&ws_shape_function[0]);
+
+        for ( stk::mesh::Bucket::size_type k = 0; k < length; ++k ) {
+            stk::mesh::Entity elem = b[k];
+
+            stk::mesh::Entity const * node_rels = bulk_data.begin_nodes(elem);
+            const int num_nodes = bulk_data.num_nodes(elem);
+
+            // sanity check on num nodes
+            ThrowAssert( num_nodes == nodesPerElement );
+
+            const double * p_scs_areav = (NULL != geomCache) ? geomCache->scs_areav(elem) : NULL;
+            const double * p_dndx = useCachedDndx ? geomCache->dndx(elem) : NULL;
+
+            for ( int ni = 0; ni < num_nodes; ++ni ) {
+                stk::mesh::Entity node = node_rels[ni];
+                rowLids[ni] = linsys_.entity_row_lid(node);
+                xElem[ni] = xCol(linsys_.entity_col_lid(node), vec);
+                ws_thermalCond[ni] = *stk::mesh::field_data(*thermalCond_, node);
+
+                if ( NULL == p_scs_areav || NULL == p_dndx ) {
+                    const double * coords = stk::mesh::field_data(*coordinates_, node);
+                    for ( int j = 0; j < nDim; ++j )
+                        ws_coordinates[ni*nDim+j] = coords[j];
+                }
+            }
+
+            // compute geometry
+            double scs_error = 0.0;
+            if ( NULL == p_scs_areav ) {
+                meSCS->determinant(1, &ws_coordinates[0], &ws_scs_areav[0], &scs_error);
+                p_scs_areav = &ws_scs_areav[0];
+            }
+            if ( NULL == p_dndx ) {
+                if ( shiftedGradOp_ )
+                    meSCS->shifted_grad_op(1, &ws_coordinates[0], &ws_dndx[0], &ws_deriv[0], &ws_det_j[0], &scs_error);
+                else
+                    meSCS->grad_op(1, &ws_coordinates[0], &ws_dndx[0], &ws_deriv[0], &ws_det_j[0], &scs_error);
+                p_dndx = &ws_dndx[0];
+            }
+
+            for ( int ip = 0; ip < numScsIp; ++ip ) {
+                // left and right nodes for this ip
+                const int il = lrscv[2*ip];
+                const int ir = lrscv[2*ip+1];
+
+                double kIp = 0.0;
+                const int offSetSF = ip*nodesPerElement;
+                for ( int ic = 0; ic < nodesPerElement; ++ic )
+                    kIp += ws_shape_function[offSetSF+ic]*ws_thermalCond[ic];
+
+                // rows il and ir without their diagonal; that one is assembled
+                double fluxL = 0.0;
+                double fluxR = 0.0;
+                for ( int ic = 0; ic < nodesPerElement; ++ic ) {
+                    const int offSetDnDx = nDim*nodesPerElement*ip + ic*nDim;
+                    double lhsfacDiff = 0.0;
+                    for ( int j = 0; j < nDim; ++j )
+                        lhsfacDiff += -kIp*p_dndx[offSetDnDx+j]*p_scs_areav[ip*nDim+j];
+
+                    const double contrib = lhsfacDiff*xElem[ic];
+                    if ( ic != il )
+                        fluxL += contrib;
+                    if ( ic != ir )
+                        fluxR -= contrib;
+                }
+
+                add_to_row(rowLids[il], fluxL, yOwned, ySharedNotOwned, vec);
+                add_to_row(rowLids[ir], fluxR, yOwned, ySharedNotOwned, vec);
+            }
+        }
+    }
+}
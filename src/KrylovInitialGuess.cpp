@@ -0,0 +1,164 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "KrylovInitialGuess.h"
+
+#include <stk_util/util/ReportHandler.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// KrylovInitialGuess - initial guess from earlier solutions
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+KrylovInitialGuess::KrylovInitialGuess(const std::string & type, const int historySize) :
+    type_(ZERO),
+    historySize_(std::max(1, historySize)),
+    residualRatio_(1.0)
+{
+    if ( type == "zero" )
+        type_ = ZERO;
+    else if ( type == "previous" )
+        type_ = PREVIOUS;
+    else if ( type == "extrapolation" )
+        type_ = EXTRAPOLATION;
+    else if ( type == "projection" )
+        type_ = PROJECTION;
+    else
+        throw std::runtime_error("KrylovInitialGuess: unknown initial_guess " + type);
+
+    if ( type_ == PREVIOUS )
+        historySize_ = 1;
+}
+
+//--------------------------------------------------------------------------
+//-------- clear -----------------------------------------------------------
+//--------------------------------------------------------------------------
+void KrylovInitialGuess::clear() {
+    history_.clear();
+    basis_.clear();
+    images_.clear();
+    residual_ = Teuchos::null;
+    residualRatio_ = 1.0;
+}
+
+//--------------------------------------------------------------------------
+//-------- store -----------------------------------------------------------
+//--------------------------------------------------------------------------
+void KrylovInitialGuess::store(const LinSys::Vector & x, const size_t slot) {
+    if ( !active() )
+        return;
+
+    if ( slot >= history_.size() )
+        history_.resize(slot+1);
+    std::deque<Teuchos::RCP<LinSys::Vector> > & history = history_[slot];
+
+    // recycle the oldest vector once the history is full
+    Teuchos::RCP<LinSys::Vector> v;
+    if ( history.size() == historySize_ ) {
+        v = history.back();
+        history.pop_back();
+    }
+    else {
+        v = Teuchos::rcp(new LinSys::Vector(x.getMap()));
+    }
+    v->update(1.0, x, 0.0);
+    history.push_front(v);
+}
+
+//--------------------------------------------------------------------------
+//-------- compute ---------------------------------------------------------
+//--------------------------------------------------------------------------
+void KrylovInitialGuess::compute(const LinSys::Operator & A,
+                                 const LinSys::Vector & b,
+                                 LinSys::Vector & x,
+                                 const size_t slot) {
+    x.putScalar(0.0);
+    residualRatio_ = 1.0;
+    if ( !active() || slot >= history_.size() || history_[slot].empty() )
+        return;
+
+    const std::deque<Teuchos::RCP<LinSys::Vector> > & history = history_[slot];
+    const double bNorm = b.norm2();
+    if ( bNorm == 0.0 )
+        return;
+
+    if ( residual_.is_null() )
+        residual_ = Teuchos::rcp(new LinSys::Vector(b.getMap()));
+
+    if ( type_ == PROJECTION ) {
+        project(A, b, x, history);
+        residualRatio_ = residual_->norm2()/bNorm;
+        return;
+    }
+
+    if ( type_ == PREVIOUS ) {
+        x.update(1.0, *history[0], 0.0);
+    }
+    else {
+        // the polynomial of degree m-1 through the last m solutions, taken one
+        // step further: x0 = sum_j (-1)^j binom(m, j+1) x_(n-j)
+        const int m = history.size();
+        double coeff = m;
+        for ( int j = 0; j < m; ++j ) {
+            x.update(coeff, *history[j], 1.0);
+            coeff = -coeff*(m - j - 1)/(j + 2);
+        }
+    }
+
+    A.apply(x, *residual_);
+    residual_->update(1.0, b, -1.0);
+    residualRatio_ = residual_->norm2()/bNorm;
+}
+
+//--------------------------------------------------------------------------
+//-------- project ---------------------------------------------------------
+//--------------------------------------------------------------------------
+void KrylovInitialGuess::project(const LinSys::Operator & A,
+                                 const LinSys::Vector & b,
+                                 LinSys::Vector & x,
+                                 const std::deque<Teuchos::RCP<LinSys::Vector> > & history) {
+    // solutions that are (nearly) dependent on the earlier ones are skipped
+    const double dropTolerance = 1.0e-10;
+
+    const size_t m = history.size();
+    while ( basis_.size() < m ) {
+        basis_.push_back(Teuchos::rcp(new LinSys::Vector(b.getMap())));
+        images_.push_back(Teuchos::rcp(new LinSys::Vector(b.getMap())));
+    }
+
+    // r = b - A x0 is updated along with x0
+    residual_->update(1.0, b, 0.0);
+
+    size_t numBasis = 0;
+    for ( size_t i = 0; i < m; ++i ) {
+        LinSys::Vector & z = *basis_[numBasis];
+        LinSys::Vector & w = *images_[numBasis];
+        z.update(1.0, *history[i], 0.0);
+        A.apply(z, w);
+
+        const double wNorm = w.norm2();
+        for ( size_t j = 0; j < numBasis; ++j ) {
+            const double alpha = images_[j]->dot(w);
+            w.update(-alpha, *images_[j], 1.0);
+            z.update(-alpha, *basis_[j], 1.0);
+        }
+        const double nrm = w.norm2();
+        if ( nrm <= dropTolerance*wNorm || nrm == 0.0 )
+            continue;
+        w.scale(1.0/nrm);
+        z.scale(1.0/nrm);
+
+        // least squares coefficient of the new orthonormal image
+        const double beta = w.dot(*residual_);
+        x.update(beta, z, 1.0);
+        residual_->update(-beta, w, 1.0);
+        ++numBasis;
+    }
+}
@@ -42,7 +42,8 @@ LinearSolver::LinearSolver(std::string name, LinearSolvers * linearSolvers, Line
     config_(config),
     recomputePreconditioner_(config->recomputePreconditioner()),
     reusePreconditioner_(config->reusePreconditioner()),
-    timerPrecond_(0.0)
+    timerPrecond_(0.0),
+    precondComputed_(false)
 {
     // nothing to do
 }
@@ -74,6 +75,10 @@ double LinearSolver::get_timer_precond() {
     return timerPrecond_;
 }
 
+bool LinearSolver::get_precond_computed() { 
+    return precondComputed_;
+}
+
 LinearSolverConfig * LinearSolver::getConfig() { 
     return config_; 
 }
\ No newline at end of file
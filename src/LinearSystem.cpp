@@ -12,6 +12,7 @@
 #include <master_element/MasterElement.h>
 
 #include <stk_util/parallel/Parallel.hpp>
+#include <stk_util/util/ReportHandler.hpp>
 
 #include <stk_util/parallel/ParallelReduce.hpp>
 #include <stk_mesh/base/BulkData.hpp>
@@ -27,6 +28,7 @@
 #include <Teuchos_FancyOStream.hpp>
 
 #include <sstream>
+#include <limits>
 
 LinearSystem::LinearSystem(Realm &realm, const unsigned numDof, EquationSystem *eqSys, LinearSolver *linearSolver) : 
     realm_(realm),
@@ -39,10 +41,15 @@ LinearSystem::LinearSystem(Realm &realm, const unsigned numDof, EquationSystem *
     linearSolveIterations_(0),
     nonLinearResidual_(0.0),
     linearResidual_(0.0),
+    initialGuessActive_(false),
+    initialGuessResidual_(1.0),
     firstNonLinearResidual_(1.0e8),
     scaledNonLinearResidual_(1.0e8),
     recomputePreconditioner_(true),
     reusePreconditioner_(false),
+    numElemColors_(0),
+    atomicFreeAssembly_(false),
+    meshModificationCount_(std::numeric_limits<size_t>::max()),
     provideOutput_(true)
 {
     // nothing to do
@@ -60,6 +67,18 @@ double LinearSystem::get_timer_precond() {
     return linearSolver_->get_timer_precond();
 }
 
+bool LinearSystem::get_precond_computed() {
+    return linearSolver_->get_precond_computed();
+}
+
+bool LinearSystem::mesh_unchanged() const {
+    return realm_.bulk_data().synchronized_count() == meshModificationCount_;
+}
+
+void LinearSystem::record_mesh_state() {
+    meshModificationCount_ = realm_.bulk_data().synchronized_count();
+}
+
 bool LinearSystem::debug() {
     if (linearSolver_ && linearSolver_->root() && linearSolver_->root()->debug()) return true;
     return false;
@@ -78,6 +97,26 @@ LinearSystem *LinearSystem::create(Realm & realm, const unsigned numDof, Equatio
     return 0;
 }
 
+void LinearSystem::sumIntoDiagonal(const unsigned numEntities,
+                                   const stk::mesh::Entity * entities,
+                                   const double * lhs,
+                                   const double * rhs) {
+    ThrowRequireMsg(numDof_ == 1, "sumIntoDiagonal requires a single dof equation");
+
+    // one 1x1 sumInto per entity
+    std::vector<stk::mesh::Entity> entity(1);
+    std::vector<int> scratchIds(1);
+    std::vector<double> scratchVals(1);
+    std::vector<double> lhsEntity(1);
+    std::vector<double> rhsEntity(1);
+    for (unsigned i = 0; i < numEntities; ++i) {
+        entity[0] = entities[i];
+        lhsEntity[0] = lhs[i];
+        rhsEntity[0] = rhs[i];
+        sumInto(entity, scratchIds, scratchVals, rhsEntity, lhsEntity, __FILE__);
+    }
+}
+
 void LinearSystem::sync_field(const stk::mesh::FieldBase *field) {
     std::vector< const stk::mesh::FieldBase *> fields(1,field);
     stk::mesh::BulkData& bulkData = realm_.bulk_data();
@@ -0,0 +1,213 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "MatrixFreeOperator.h"
+
+#include <stk_util/util/ReportHandler.hpp>
+
+#include <Tpetra_Export.hpp>
+#include <Tpetra_Import.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// MatrixFreeOperator - element-by-element operator of a TpetraLinearSystem
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+MatrixFreeOperator::MatrixFreeOperator(const TpetraLinearSystem & linsys) :
+    linsys_(linsys)
+{
+    // nothing to do
+}
+
+Teuchos::RCP<const LinSys::Map> MatrixFreeOperator::getDomainMap() const {
+    return linsys_.getOwnedRowsMap();
+}
+
+Teuchos::RCP<const LinSys::Map> MatrixFreeOperator::getRangeMap() const {
+    return linsys_.getOwnedRowsMap();
+}
+
+//--------------------------------------------------------------------------
+//-------- allocate_work_vectors -------------------------------------------
+//--------------------------------------------------------------------------
+void MatrixFreeOperator::allocate_work_vectors(const size_t numVecs) const {
+    if ( !xCol_.is_null() && xCol_->getNumVectors() == numVecs )
+        return;
+
+    xCol_ = Teuchos::rcp(new LinSys::MultiVector(linsys_.getColumnImporter()->getTargetMap(), numVecs));
+    yOwned_ = Teuchos::rcp(new LinSys::MultiVector(linsys_.getOwnedRowsMap(), numVecs));
+    ySharedNotOwned_ = Teuchos::rcp(new LinSys::MultiVector(linsys_.getSharedNotOwnedRowsMap(), numVecs));
+}
+
+//--------------------------------------------------------------------------
+//-------- apply -----------------------------------------------------------
+//--------------------------------------------------------------------------
+void MatrixFreeOperator::apply(const LinSys::MultiVector & X,
+                               LinSys::MultiVector & Y,
+                               Teuchos::ETransp mode,
+                               LinSys::Scalar alpha,
+                               LinSys::Scalar beta) const {
+    ThrowRequireMsg(mode == Teuchos::NO_TRANS, "MatrixFreeOperator only supports NO_TRANS");
+
+    const size_t numVecs = X.getNumVectors();
+    allocate_work_vectors(numVecs);
+
+    // owned values plus the sharedNotOwned/ghosted ones the local elements need
+    xCol_->doImport(X, *linsys_.getColumnImporter(), Tpetra::INSERT);
+    yOwned_->putScalar(0.0);
+    ySharedNotOwned_->putScalar(0.0);
+
+    host_view_type xColView = xCol_->getLocalView<HostSpace>();
+    host_view_type yOwnedView = yOwned_->getLocalView<HostSpace>();
+    host_view_type ySharedView = ySharedNotOwned_->getLocalView<HostSpace>();
+    for ( size_t vec = 0; vec < numVecs; ++vec )
+        apply_off_diagonal(xColView, yOwnedView, ySharedView, vec);
+
+    yOwned_->doExport(*ySharedNotOwned_, *linsys_.getExporter(), Tpetra::ADD);
+
+    // Dirichlet and reset rows keep their diagonal only
+    host_view_type xView = X.getLocalView<HostSpace>();
+    host_view_type diagView = linsys_.getMatrixFreeDiagonal()->getLocalView<HostSpace>();
+    host_view_type maskView = linsys_.getDirichletMask()->getLocalView<HostSpace>();
+    const size_t numRows = yOwnedView.extent(0);
+    for ( size_t vec = 0; vec < numVecs; ++vec ) {
+        for ( size_t i = 0; i < numRows; ++i ) {
+            yOwnedView(i,vec) = maskView(i,0)*yOwnedView(i,vec) + diagView(i,0)*xView(i,vec);
+        }
+    }
+
+    Y.update(alpha, *yOwned_, beta);
+}
+
+//--------------------------------------------------------------------------
+//-------- add_to_row ------------------------------------------------------
+//--------------------------------------------------------------------------
+void MatrixFreeOperator::add_to_row(const LinSys::LocalOrdinal rowLid, const double value,
+                                    const host_view_type & yOwned,
+                                    const host_view_type & ySharedNotOwned,
+                                    const size_t vec) const {
+    if ( rowLid < linsys_.max_owned_row_id() )
+        yOwned(rowLid,vec) += value;
+    else if ( rowLid < linsys_.max_shared_not_owned_row_id() )
+        ySharedNotOwned(rowLid - linsys_.max_owned_row_id(),vec) += value;
+}
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// MatrixFreePreconditioner - Jacobi or Chebyshev from the diagonal
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+MatrixFreePreconditioner::MatrixFreePreconditioner(Teuchos::RCP<const LinSys::Operator> A,
+                                                   Teuchos::RCP<const LinSys::Vector> diagonal,
+                                                   const std::string & type,
+                                                   const int degree) :
+    A_(A),
+    diagonal_(diagonal),
+    useChebyshev_(type == "chebyshev"),
+    degree_(std::max(1, degree)),
+    lambdaMax_(1.0),
+    lambdaMin_(1.0/30.0)
+{
+    invDiagonal_ = Teuchos::rcp(new LinSys::Vector(diagonal_->getMap()));
+}
+
+//--------------------------------------------------------------------------
+//-------- compute ---------------------------------------------------------
+//--------------------------------------------------------------------------
+void MatrixFreePreconditioner::compute() {
+    host_view_type diagView = diagonal_->getLocalView<HostSpace>();
+    host_view_type invDiagView = invDiagonal_->getLocalView<HostSpace>();
+
+    // rows zeroed by resetRows have no diagonal; leave them untouched
+    const double tiny = std::numeric_limits<double>::min();
+    const size_t numRows = diagView.extent(0);
+    for ( size_t i = 0; i < numRows; ++i ) {
+        const double d = diagView(i,0);
+        invDiagView(i,0) = (std::abs(d) > tiny) ? 1.0/d : 1.0;
+    }
+
+    if ( useChebyshev_ ) {
+        // boost the estimate as Ifpack2 does; the smallest eigenvalue is not resolved
+        lambdaMax_ = 1.1*estimate_lambda_max();
+        lambdaMin_ = lambdaMax_/30.0;
+    }
+}
+
+//--------------------------------------------------------------------------
+//-------- estimate_lambda_max ---------------------------------------------
+//--------------------------------------------------------------------------
+double MatrixFreePreconditioner::estimate_lambda_max() const {
+    const int numPowerIterations = 10;
+
+    LinSys::Vector x(diagonal_->getMap());
+    LinSys::Vector y(diagonal_->getMap());
+    LinSys::Vector z(diagonal_->getMap());
+
+    x.randomize();
+    double lambda = 0.0;
+    double xNorm = x.norm2();
+    for ( int i = 0; i < numPowerIterations && xNorm > 0.0; ++i ) {
+        x.scale(1.0/xNorm);
+        A_->apply(x, y);
+        z.elementWiseMultiply(1.0, *invDiagonal_, y, 0.0);
+        lambda = z.norm2();
+        x.update(1.0, z, 0.0);
+        xNorm = lambda;
+    }
+    return lambda > 0.0 ? lambda : 1.0;
+}
+
+//--------------------------------------------------------------------------
+//-------- apply -----------------------------------------------------------
+//--------------------------------------------------------------------------
+void MatrixFreePreconditioner::apply(const LinSys::MultiVector & X,
+                                     LinSys::MultiVector & Y,
+                                     Teuchos::ETransp mode,
+                                     LinSys::Scalar alpha,
+                                     LinSys::Scalar beta) const {
+    if ( !useChebyshev_ ) {
+        // Jacobi; Y = alpha*D^-1 X + beta*Y
+        Y.elementWiseMultiply(alpha, *invDiagonal_, X, beta);
+        return;
+    }
+
+    // Chebyshev iteration for A Z = X starting from Z = 0
+    const size_t numVecs = X.getNumVectors();
+    LinSys::MultiVector Z(X.getMap(), numVecs);
+    LinSys::MultiVector W(X.getMap(), numVecs);
+    LinSys::MultiVector R(X.getMap(), numVecs);
+
+    const double theta = 0.5*(lambdaMax_ + lambdaMin_);
+    const double delta = 0.5*(lambdaMax_ - lambdaMin_);
+    const double s1 = theta/delta;
+    double rhok = 1.0/s1;
+
+    W.elementWiseMultiply(1.0/theta, *invDiagonal_, X, 0.0);
+    Z.update(1.0, W, 0.0);
+
+    for ( int k = 1; k < degree_; ++k ) {
+        const double rhokp1 = 1.0/(2.0*s1 - rhok);
+        const double dtemp1 = rhokp1*rhok;
+        const double dtemp2 = 2.0*rhokp1/delta;
+        rhok = rhokp1;
+
+        // R = X - A Z; W = dtemp1*W + dtemp2*D^-1 R
+        A_->apply(Z, R);
+        R.update(1.0, X, -1.0);
+        W.elementWiseMultiply(dtemp2, *invDiagonal_, R, dtemp1);
+        Z.update(1.0, W, 1.0);
+    }
+
+    Y.update(alpha, Z, beta);
+}
@@ -0,0 +1,307 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "MeshCache.h"
+
+#include <HOFlowEnv.h>
+
+#include <stk_io/StkMeshIoBroker.hpp>
+#include <Ioss_Utils.h>
+
+#include <cstdio>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+const char cacheMagic[8] = {'H','O','F','L','O','W','M','C'};
+const uint32_t cacheVersion = 1;
+const uint64_t fnvOffsetBasis = 14695981039346656037ULL;
+const uint64_t fnvPrime = 1099511628211ULL;
+}
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// MeshCache - cache directory of the preprocessed mesh
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+MeshCache::MeshCache(stk::ParallelMachine comm, const std::string & directory,
+                     const std::string & inputDBName, const std::string & decompType) :
+    comm_(comm),
+    directory_(directory),
+    decomposed_("None" != decompType),
+    key_(fnvOffsetBasis),
+    hasMesh_(false),
+    numHits_(0),
+    numMisses_(0)
+{
+    const int rank = stk::parallel_machine_rank(comm_);
+    const int nprocs = stk::parallel_machine_size(comm_);
+
+    // a serial file is hashed once; a decomposed mesh by all ranks
+    uint64_t meshHash = 0;
+    if ( decomposed_ ) {
+        if ( 0 == rank )
+            meshHash = hash_file(inputDBName, fnvOffsetBasis);
+        MPI_Bcast(&meshHash, 1, MPI_UINT64_T, 0, comm_);
+    }
+    else {
+        const std::string rankFile = nprocs > 1 ? Ioss::Utils::decode_filename(inputDBName, rank, nprocs) : inputDBName;
+        uint64_t rankHash = hash_file(rankFile, fnvOffsetBasis);
+        rankHash = hash_bytes(&rank, sizeof(rank), rankHash);
+        MPI_Allreduce(&rankHash, &meshHash, 1, MPI_UINT64_T, MPI_BXOR, comm_);
+    }
+
+    key_ = hash_bytes(&meshHash, sizeof(meshHash), key_);
+    key_ = hash_bytes(&nprocs, sizeof(nprocs), key_);
+    key_ = hash_bytes(decompType.data(), decompType.size(), key_);
+
+    // the directory is shared; the decomposed mesh is complete once marked
+    int meshComplete = 0;
+    if ( 0 == rank ) {
+        mkdir(directory_.c_str(), 0755);
+        struct stat markerStat;
+        meshComplete = decomposed_ && 0 == stat((mesh_file() + ".complete").c_str(), &markerStat);
+    }
+    MPI_Bcast(&meshComplete, 1, MPI_INT, 0, comm_);
+    hasMesh_ = (1 == meshComplete);
+
+    HOFlowEnv::self().hoflowOutputP0() << "MeshCache: " << prefix()
+        << (decomposed_ ? (hasMesh_ ? " (decomposed mesh cached)" : " (decomposed mesh not cached)") : "") << std::endl;
+}
+
+//--------------------------------------------------------------------------
+//-------- destructor ------------------------------------------------------
+//--------------------------------------------------------------------------
+MeshCache::~MeshCache()
+{
+    // nothing to do
+}
+
+//--------------------------------------------------------------------------
+//-------- prefix ----------------------------------------------------------
+//--------------------------------------------------------------------------
+std::string
+MeshCache::prefix() const
+{
+    std::ostringstream name;
+    name << directory_ << "/hoflow_" << std::hex << std::setfill('0') << std::setw(16) << key_
+         << std::dec << "_np" << stk::parallel_machine_size(comm_);
+    return name.str();
+}
+
+//--------------------------------------------------------------------------
+//-------- mesh_file -------------------------------------------------------
+//--------------------------------------------------------------------------
+std::string
+MeshCache::mesh_file() const
+{
+    return prefix() + ".exo";
+}
+
+//--------------------------------------------------------------------------
+//-------- rank_file -------------------------------------------------------
+//--------------------------------------------------------------------------
+std::string
+MeshCache::rank_file(const std::string & name) const
+{
+    std::ostringstream fileName;
+    fileName << prefix() << "_r" << stk::parallel_machine_rank(comm_) << "_" << name << ".bin";
+    return fileName.str();
+}
+
+//--------------------------------------------------------------------------
+//-------- store_mesh ------------------------------------------------------
+//--------------------------------------------------------------------------
+void
+MeshCache::store_mesh(stk::io::StkMeshIoBroker & ioBroker)
+{
+    if ( !decomposed_ || hasMesh_ )
+        return;
+
+    const size_t meshIndex = ioBroker.create_output_mesh(mesh_file(), stk::io::WRITE_RESULTS);
+    ioBroker.write_output_mesh(meshIndex);
+    ioBroker.close_output_mesh(meshIndex);
+
+    // mark complete once every rank has closed its file
+    MPI_Barrier(comm_);
+    if ( 0 == stk::parallel_machine_rank(comm_) ) {
+        std::ofstream marker((mesh_file() + ".complete").c_str());
+        marker << stk::parallel_machine_size(comm_) << std::endl;
+    }
+    hasMesh_ = true;
+}
+
+//--------------------------------------------------------------------------
+//-------- hash_file -------------------------------------------------------
+//--------------------------------------------------------------------------
+uint64_t
+MeshCache::hash_file(const std::string & fileName, uint64_t hash)
+{
+    std::ifstream stream(fileName.c_str(), std::ios::binary);
+    if ( !stream )
+        throw std::runtime_error("MeshCache: can not read the mesh file " + fileName);
+
+    std::vector<char> buffer(1 << 20);
+    while ( stream ) {
+        stream.read(buffer.data(), buffer.size());
+        hash = hash_bytes(buffer.data(), stream.gcount(), hash);
+    }
+    return hash;
+}
+
+//--------------------------------------------------------------------------
+//-------- hash_bytes ------------------------------------------------------
+//--------------------------------------------------------------------------
+uint64_t
+MeshCache::hash_bytes(const void * data, const size_t numBytes, uint64_t hash)
+{
+    const unsigned char * bytes = static_cast<const unsigned char *>(data);
+    for ( size_t k = 0; k < numBytes; ++k ) {
+        hash ^= bytes[k];
+        hash *= fnvPrime;
+    }
+    return hash;
+}
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// MeshCacheReader - memory mapped cache file
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+MeshCacheReader::MeshCacheReader(const std::string & fileName) :
+    data_(NULL),
+    size_(0),
+    pos_(0)
+{
+    const int fd = open(fileName.c_str(), O_RDONLY);
+    if ( fd < 0 )
+        return;
+
+    struct stat fileStat;
+    if ( 0 == fstat(fd, &fileStat) && fileStat.st_size > 0 ) {
+        void * map = mmap(NULL, fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if ( MAP_FAILED != map ) {
+            data_ = static_cast<const char *>(map);
+            size_ = fileStat.st_size;
+        }
+    }
+    // the mapping stays valid after close
+    ::close(fd);
+
+    char magic[sizeof(cacheMagic)];
+    uint32_t version = 0;
+    if ( NULL != data_ && !(read_raw(magic, sizeof(magic)) && read(version)
+                            && 0 == std::memcmp(magic, cacheMagic, sizeof(magic))
+                            && cacheVersion == version) ) {
+        munmap(const_cast<char *>(data_), size_);
+        data_ = NULL;
+    }
+}
+
+//--------------------------------------------------------------------------
+//-------- destructor ------------------------------------------------------
+//--------------------------------------------------------------------------
+MeshCacheReader::~MeshCacheReader()
+{
+    if ( NULL != data_ )
+        munmap(const_cast<char *>(data_), size_);
+}
+
+//--------------------------------------------------------------------------
+//-------- read ------------------------------------------------------------
+//--------------------------------------------------------------------------
+bool
+MeshCacheReader::read(std::string & value)
+{
+    std::vector<char> chars;
+    if ( !read(chars) )
+        return false;
+    value.assign(chars.begin(), chars.end());
+    return true;
+}
+
+//--------------------------------------------------------------------------
+//-------- read_raw --------------------------------------------------------
+//--------------------------------------------------------------------------
+bool
+MeshCacheReader::read_raw(void * dest, const size_t numBytes)
+{
+    if ( NULL == data_ || numBytes > size_ - pos_ )
+        return false;
+    std::memcpy(dest, data_ + pos_, numBytes);
+    pos_ += numBytes;
+    return true;
+}
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// MeshCacheWriter - sequential cache file
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+MeshCacheWriter::MeshCacheWriter(const std::string & fileName) :
+    fileName_(fileName),
+    tmpName_(fileName + ".tmp"),
+    stream_(tmpName_.c_str(), std::ios::binary | std::ios::trunc)
+{
+    write_raw(cacheMagic, sizeof(cacheMagic));
+    write(cacheVersion);
+}
+
+//--------------------------------------------------------------------------
+//-------- destructor ------------------------------------------------------
+//--------------------------------------------------------------------------
+MeshCacheWriter::~MeshCacheWriter()
+{
+    // not closed; drop the partial entry
+    if ( stream_.is_open() ) {
+        stream_.close();
+        std::remove(tmpName_.c_str());
+    }
+}
+
+//--------------------------------------------------------------------------
+//-------- write -----------------------------------------------------------
+//--------------------------------------------------------------------------
+void
+MeshCacheWriter::write(const std::string & value)
+{
+    write(std::vector<char>(value.begin(), value.end()));
+}
+
+//--------------------------------------------------------------------------
+//-------- close -----------------------------------------------------------
+//--------------------------------------------------------------------------
+bool
+MeshCacheWriter::close()
+{
+    stream_.close();
+    const bool ok = !stream_.fail() && 0 == std::rename(tmpName_.c_str(), fileName_.c_str());
+    if ( !ok )
+        std::remove(tmpName_.c_str());
+    return ok;
+}
+
+//--------------------------------------------------------------------------
+//-------- write_raw -------------------------------------------------------
+//--------------------------------------------------------------------------
+void
+MeshCacheWriter::write_raw(const void * src, const size_t numBytes)
+{
+    stream_.write(static_cast<const char *>(src), numBytes);
+}
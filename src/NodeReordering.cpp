@@ -0,0 +1,314 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "NodeReordering.h"
+
+#include <Realm.h>
+#include <FieldTypeDef.h>
+
+// stk_mesh/base/fem
+#include <stk_mesh/base/BulkData.hpp>
+#include <stk_mesh/base/Field.hpp>
+#include <stk_mesh/base/MetaData.hpp>
+
+#include <stk_util/util/ReportHandler.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <utility>
+
+//==========================================================================
+// Class Definition
+//==========================================================================
+// NodeReordering - rcm or hilbert order of the owned rows
+//==========================================================================
+//--------------------------------------------------------------------------
+//-------- constructor -----------------------------------------------------
+//--------------------------------------------------------------------------
+NodeReordering::NodeReordering(Realm & realm, const std::string & type) :
+    bandwidthBefore_(0),
+    bandwidthAfter_(0),
+    realm_(realm),
+    type_(type)
+{
+    if ( type_ != "rcm" && type_ != "hilbert" )
+        throw std::runtime_error("NodeReordering: unknown node_reordering type " + type_);
+}
+
+//--------------------------------------------------------------------------
+//-------- destructor ------------------------------------------------------
+//--------------------------------------------------------------------------
+NodeReordering::~NodeReordering()
+{
+    // nothing to do
+}
+
+//--------------------------------------------------------------------------
+//-------- apply -----------------------------------------------------------
+//--------------------------------------------------------------------------
+void NodeReordering::apply(std::vector<stk::mesh::Entity> & nodes) {
+    const size_t numNodes = nodes.size();
+
+    build_adjacency(nodes);
+
+    std::vector<size_t> position(numNodes);
+    std::iota(position.begin(), position.end(), 0);
+    bandwidthBefore_ = bandwidth(position);
+
+    std::vector<size_t> newToOld;
+    if ( type_ == "rcm" )
+        rcm_order(newToOld);
+    else
+        hilbert_order(nodes, newToOld);
+
+    ThrowRequire(newToOld.size() == numNodes);
+
+    std::vector<stk::mesh::Entity> reordered(numNodes);
+    for ( size_t k = 0; k < numNodes; ++k ) {
+        reordered[k] = nodes[newToOld[k]];
+        position[newToOld[k]] = k;
+    }
+    bandwidthAfter_ = bandwidth(position);
+
+    nodes.swap(reordered);
+
+    // the graph is only needed here
+    std::vector<size_t>().swap(adjOffsets_);
+    std::vector<size_t>().swap(adjNodes_);
+}
+
+//--------------------------------------------------------------------------
+//-------- build_adjacency -------------------------------------------------
+//--------------------------------------------------------------------------
+void NodeReordering::build_adjacency(const std::vector<stk::mesh::Entity> & nodes) {
+    stk::mesh::BulkData & bulk_data = realm_.bulk_data();
+
+    const size_t invalidIndex = std::numeric_limits<size_t>::max();
+    std::vector<size_t> nodeIndex(bulk_data.get_size_of_entity_index_space(), invalidIndex);
+    for ( size_t i = 0; i < nodes.size(); ++i )
+        nodeIndex[nodes[i].local_offset()] = i;
+
+    adjOffsets_.assign(nodes.size()+1, 0);
+    adjNodes_.clear();
+
+    std::vector<size_t> nbrs;
+    for ( size_t i = 0; i < nodes.size(); ++i ) {
+        nbrs.clear();
+
+        stk::mesh::Entity const * elem_rels = bulk_data.begin_elements(nodes[i]);
+        const int num_elems = bulk_data.num_elements(nodes[i]);
+        for ( int ie = 0; ie < num_elems; ++ie ) {
+            stk::mesh::Entity const * node_rels = bulk_data.begin_nodes(elem_rels[ie]);
+            const int num_nodes = bulk_data.num_nodes(elem_rels[ie]);
+            for ( int ni = 0; ni < num_nodes; ++ni ) {
+                const size_t j = nodeIndex[node_rels[ni].local_offset()];
+                if ( j != invalidIndex && j != i )
+                    nbrs.push_back(j);
+            }
+        }
+
+        std::sort(nbrs.begin(), nbrs.end());
+        nbrs.erase(std::unique(nbrs.begin(), nbrs.end()), nbrs.end());
+        adjNodes_.insert(adjNodes_.end(), nbrs.begin(), nbrs.end());
+        adjOffsets_[i+1] = adjNodes_.size();
+    }
+}
+
+//--------------------------------------------------------------------------
+//-------- level_structure -------------------------------------------------
+//--------------------------------------------------------------------------
+size_t NodeReordering::level_structure(const size_t root,
+                                       std::vector<int> & level,
+                                       std::vector<size_t> & lastLevel) const {
+    // level is -1 for all nodes on entry and exit
+    std::vector<size_t> queue(1, root);
+    level[root] = 0;
+    for ( size_t head = 0; head < queue.size(); ++head ) {
+        const size_t v = queue[head];
+        for ( size_t k = adjOffsets_[v]; k < adjOffsets_[v+1]; ++k ) {
+            const size_t w = adjNodes_[k];
+            if ( level[w] < 0 ) {
+                level[w] = level[v] + 1;
+                queue.push_back(w);
+            }
+        }
+    }
+
+    const int depth = level[queue.back()];
+    lastLevel.clear();
+    for ( size_t v : queue ) {
+        if ( level[v] == depth )
+            lastLevel.push_back(v);
+        level[v] = -1;
+    }
+    return depth;
+}
+
+//--------------------------------------------------------------------------
+//-------- rcm_order -------------------------------------------------------
+//--------------------------------------------------------------------------
+void NodeReordering::rcm_order(std::vector<size_t> & newToOld) const {
+    const size_t numNodes = adjOffsets_.size() - 1;
+
+    std::vector<char> visited(numNodes, 0);
+    std::vector<int> level(numNodes, -1);
+    std::vector<size_t> lastLevel;
+    std::vector<std::pair<size_t, size_t> > nbrs;
+
+    newToOld.clear();
+    newToOld.reserve(numNodes);
+
+    for ( size_t seed = 0; seed < numNodes; ++seed ) {
+        if ( visited[seed] )
+            continue;
+
+        // pseudo-peripheral root of this component (George and Liu); keep the
+        // lowest degree node of the last level set while the depth increases
+        size_t root = seed;
+        size_t depth = level_structure(root, level, lastLevel);
+        std::vector<size_t> candidateLastLevel;
+        for ( int sweep = 0; sweep < 5; ++sweep ) {
+            size_t candidate = lastLevel[0];
+            for ( size_t v : lastLevel ) {
+                if ( adjOffsets_[v+1] - adjOffsets_[v] < adjOffsets_[candidate+1] - adjOffsets_[candidate] )
+                    candidate = v;
+            }
+            const size_t candidateDepth = level_structure(candidate, level, candidateLastLevel);
+            if ( candidateDepth <= depth )
+                break;
+            root = candidate;
+            depth = candidateDepth;
+            lastLevel.swap(candidateLastLevel);
+        }
+
+        // Cuthill-McKee; neighbours in order of increasing degree
+        const size_t begin = newToOld.size();
+        newToOld.push_back(root);
+        visited[root] = 1;
+        for ( size_t head = begin; head < newToOld.size(); ++head ) {
+            const size_t v = newToOld[head];
+            nbrs.clear();
+            for ( size_t k = adjOffsets_[v]; k < adjOffsets_[v+1]; ++k ) {
+                const size_t w = adjNodes_[k];
+                if ( !visited[w] ) {
+                    visited[w] = 1;
+                    nbrs.push_back(std::make_pair(adjOffsets_[w+1] - adjOffsets_[w], w));
+                }
+            }
+            std::sort(nbrs.begin(), nbrs.end());
+            for ( const std::pair<size_t, size_t> & nbr : nbrs )
+                newToOld.push_back(nbr.second);
+        }
+    }
+
+    std::reverse(newToOld.begin(), newToOld.end());
+}
+
+//--------------------------------------------------------------------------
+//-------- hilbert_order ---------------------------------------------------
+//--------------------------------------------------------------------------
+void NodeReordering::hilbert_order(const std::vector<stk::mesh::Entity> & nodes,
+                                   std::vector<size_t> & newToOld) const {
+    stk::mesh::MetaData & meta_data = realm_.meta_data();
+    const int nDim = meta_data.spatial_dimension();
+    VectorFieldType * coordinates = meta_data.get_field<VectorFieldType>(stk::topology::NODE_RANK, realm_.get_coordinates_name());
+
+    // 64 bit keys
+    const int bits = (nDim == 3) ? 21 : 32;
+    const double maxInt = double((uint64_t(1) << bits) - 1);
+
+    // local bounding box
+    double minCoord[3] = { 0.0, 0.0, 0.0 };
+    double maxCoord[3] = { 0.0, 0.0, 0.0 };
+    for ( int j = 0; j < nDim; ++j ) {
+        minCoord[j] = std::numeric_limits<double>::max();
+        maxCoord[j] = -std::numeric_limits<double>::max();
+    }
+    for ( stk::mesh::Entity node : nodes ) {
+        const double * coords = stk::mesh::field_data(*coordinates, node);
+        for ( int j = 0; j < nDim; ++j ) {
+            minCoord[j] = std::min(minCoord[j], coords[j]);
+            maxCoord[j] = std::max(maxCoord[j], coords[j]);
+        }
+    }
+
+    double scale[3] = { 0.0, 0.0, 0.0 };
+    for ( int j = 0; j < nDim; ++j ) {
+        const double extent = maxCoord[j] - minCoord[j];
+        scale[j] = (extent > 0.0) ? maxInt/extent : 0.0;
+    }
+
+    std::vector<std::pair<uint64_t, size_t> > keys(nodes.size());
+    unsigned X[3];
+    for ( size_t i = 0; i < nodes.size(); ++i ) {
+        const double * coords = stk::mesh::field_data(*coordinates, nodes[i]);
+        for ( int j = 0; j < nDim; ++j )
+            X[j] = static_cast<unsigned>((coords[j] - minCoord[j])*scale[j]);
+        keys[i] = std::make_pair(hilbert_key(X, nDim, bits), i);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    newToOld.resize(nodes.size());
+    for ( size_t k = 0; k < keys.size(); ++k )
+        newToOld[k] = keys[k].second;
+}
+
+//--------------------------------------------------------------------------
+//-------- hilbert_key -----------------------------------------------------
+//--------------------------------------------------------------------------
+uint64_t NodeReordering::hilbert_key(unsigned * X, const int nDim, const int bits) {
+    // J. Skilling, Programming the Hilbert curve, AIP Conf. Proc. 707 (2004);
+    // axes to transposed Hilbert index, then interleave the bits
+    const unsigned M = 1u << (bits-1);
+    unsigned t;
+
+    for ( unsigned Q = M; Q > 1; Q >>= 1 ) {
+        const unsigned P = Q - 1;
+        for ( int i = 0; i < nDim; ++i ) {
+            if ( X[i] & Q ) {
+                X[0] ^= P;
+            }
+            else {
+                t = (X[0] ^ X[i]) & P;
+                X[0] ^= t;
+                X[i] ^= t;
+            }
+        }
+    }
+
+    // Gray encode
+    for ( int i = 1; i < nDim; ++i )
+        X[i] ^= X[i-1];
+    t = 0;
+    for ( unsigned Q = M; Q > 1; Q >>= 1 ) {
+        if ( X[nDim-1] & Q )
+            t ^= Q - 1;
+    }
+    for ( int i = 0; i < nDim; ++i )
+        X[i] ^= t;
+
+    uint64_t key = 0;
+    for ( int b = bits-1; b >= 0; --b ) {
+        for ( int i = 0; i < nDim; ++i )
+            key = (key << 1) | ((X[i] >> b) & 1u);
+    }
+    return key;
+}
+
+//--------------------------------------------------------------------------
+//-------- bandwidth -------------------------------------------------------
+//--------------------------------------------------------------------------
+size_t NodeReordering::bandwidth(const std::vector<size_t> & position) const {
+    size_t bw = 0;
+    for ( size_t i = 0; i + 1 < adjOffsets_.size(); ++i ) {
+        for ( size_t k = adjOffsets_[i]; k < adjOffsets_[i+1]; ++k ) {
+            const size_t j = adjNodes_[k];
+            const size_t diff = (position[i] > position[j]) ? position[i] - position[j] : position[j] - position[i];
+            bw = std::max(bw, diff);
+        }
+    }
+    return bw;
+}
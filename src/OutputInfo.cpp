@@ -30,6 +30,7 @@ OutputInfo::OutputInfo()
     outputFreq_(1),
     outputStart_(0),
     outputNodeSet_(false),
+    outputAsync_(false),
     serializedIOGroupSize_(0),
     hasOutputBlock_(false),
     hasRestartBlock_(false),
@@ -41,6 +42,7 @@ OutputInfo::OutputInfo()
     restartStart_(500),
     restartMaxDataBaseStepSize_(100000),
     restartNodeSet_(true),
+    restartAsync_(false),
     outputCompressionLevel_(0),
     outputCompressionShuffle_(false),
     restartCompressionLevel_(0),
@@ -88,6 +90,9 @@ void OutputInfo::load(const YAML::Node & y_node) {
         // determine if we want nodeset output
         get_if_present(y_output, "output_node_set", outputNodeSet_, outputNodeSet_);
 
+        // write the results from snapshots on a writer thread
+        get_if_present(y_output, "asynchronous_write", outputAsync_, outputAsync_);
+
         // compression options; add to manager
         if ( y_output["compression_level"] ) {
             outputCompressionLevel_ = y_output["compression_level"].as<int>() ;
@@ -155,6 +160,9 @@ void OutputInfo::load(const YAML::Node & y_node) {
         // max data base size for restart
         get_if_present(y_restart, "max_data_base_step_size", restartMaxDataBaseStepSize_, restartMaxDataBaseStepSize_);
 
+        // write the restart steps on a writer thread
+        get_if_present(y_restart, "asynchronous_write", restartAsync_, restartAsync_);
+
         // compression options; add to manager
         if ( y_restart["compression_level"] ) {
             restartCompressionLevel_ = y_restart["compression_level"].as<int>() ;
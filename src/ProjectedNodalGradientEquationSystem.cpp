@@ -123,6 +123,33 @@ void ProjectedNodalGradientEquationSystem::initialize() {
     linsys_->finalizeLinearSystem();
 }
 
+void ProjectedNodalGradientEquationSystem::reinitialize_linear_system() {
+    // the graph, maps and solver only depend on the mesh; keep them if it was not modified
+    if ( NULL != linsys_ && linsys_->mesh_unchanged() )
+        return;
+
+    // delete linsys
+    delete linsys_;
+
+    // delete old solver
+    LinearSolver *theSolver = NULL;
+    std::map<EquationType, LinearSolver *>::const_iterator iter
+      = realm_.root()->linearSolvers_->solvers_.find(eqType_);
+    if (iter != realm_.root()->linearSolvers_->solvers_.end()) {
+        theSolver = (*iter).second;
+        delete theSolver;
+    }
+
+    // create new solver
+    std::string solverName = realm_.equationSystems_.get_solver_block_name(dofName_);
+    LinearSolver * solver = realm_.root()->linearSolvers_->create_solver(solverName, eqType_);
+    linsys_ = LinearSystem::create(realm_, realm_.spatialDimension_, this, solver);
+
+    // initialize
+    solverAlgDriver_->initialize_connectivity();
+    linsys_->finalizeLinearSystem();
+}
+
 //--------------------------------------------------------------------------
 //-------- solve_and_update ------------------------------------------------
 //--------------------------------------------------------------------------
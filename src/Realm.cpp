@@ -28,11 +28,14 @@
 #include "LinearSystem.h"
 #include "TpetraLinearSystem.h"
 #include "OutputInfo.h"
+#include "AsyncOutputWriter.h"
+#include "MeshCache.h"
 #include "SolutionOptions.h"
 #include "TimeIntegrator.h"
 #include "ComputeGeometryAlgorithmDriver.h"
 #include "ComputeGeometryInteriorAlgorithm.h"
 #include "ComputeGeometryBoundaryAlgorithm.h"
+#include "ElemGeometryCache.h"
 #include "master_element/MasterElement.h"
 
 #include "hoflow_make_unique.h"
@@ -57,6 +60,10 @@
 #include <stk_mesh/base/FieldBLAS.hpp>
 
 // stk_io
+// stk_balance
+#include <stk_balance/balance.hpp>
+#include <stk_balance/balanceUtils.hpp>
+
 #include <stk_io/StkMeshIoBroker.hpp>
 #include <stk_io/IossBridge.hpp>
 #include <stk_io/InputFile.hpp>
@@ -79,7 +86,9 @@ Realm::Realm(Realms & realms, const YAML::Node & node) :
     inputDBName_("input_unknown"),
     spatialDimension_(3u),  // for convenience; can always get it from meta data
     solveFrequency_(1),
+    realmUsesEdges_(false),
     computeGeometryAlgDriver_(0),
+    elemGeometryCache_(0),
     l2Scaling_(1.0),
     metaData_(NULL),
     bulkData_(NULL),
@@ -93,7 +102,17 @@ Realm::Realm(Realms & realms, const YAML::Node & node) :
     outputInfo_(new OutputInfo()),
     node_(node),
     exposedBoundaryPart_(0),
+    sharedElementPart_(0),
     activateAura_(false),
+    autoDecompType_("None"),
+    meshCache_(NULL),
+    meshFromCache_(false),
+    doBalanceNodes_(false),
+    balanceWeight_(NULL),
+    balanceAssembleTime_(0.0),
+    balanceSolveTime_(0.0),
+    numRebalances_(0),
+    timerRebalance_(0.0),
     activateMemoryDiagnostic_(false),
     doPromotion_(false),
     promotionOrder_(0u),
@@ -119,6 +138,14 @@ Realm::Realm(Realms & realms, const YAML::Node & node) :
     timerPromoteMesh_(0.0),
     timerSortExposedFace_(0.0),
     outputCounter_(0),
+    numOutputSteps_(0),
+    outputStepsInFile_(0),
+    restartFileIndex_(99),
+    restartStepsInFile_(0),
+    outputWriter_(NULL),
+    numRestartSteps_(0),
+    timerRestartStall_(0.0),
+    maxRestartStall_(0.0),
     wallTimeStart_(stk::wall_time()),
     inputMeshIdx_(-1),
     simType_(root()->simType_)
@@ -128,11 +155,16 @@ Realm::Realm(Realms & realms, const YAML::Node & node) :
 
 //! Destructor of a computational domain
 Realm::~Realm() {
+    // finishes a pending restart step
+    delete outputWriter_;
+
     delete bulkData_;
     delete metaData_;
     delete ioBroker_;
     
     delete computeGeometryAlgDriver_;
+    delete elemGeometryCache_;
+    delete meshCache_;
 
     // prop algs
     std::vector<Algorithm *>::iterator ii;
@@ -209,13 +241,16 @@ void Realm::load(const YAML::Node & node) {
     // how often is the realm solved..
     get_if_present(node, "solve_frequency", solveFrequency_, solveFrequency_);
 
-//    // automatic decomposition
-//    get_if_present(node, "automatic_decomposition_type", autoDecompType_, autoDecompType_);
-//    if ( "None" != autoDecompType_ ) {
-//      HOFlowEnv::self().hoflowOutputP0() 
-//        <<"Warning: When using automatic_decomposition_type, one must have a serial file" << std::endl;
-//    }
-//
+    // automatic decomposition
+    get_if_present(node, "automatic_decomposition_type", autoDecompType_, autoDecompType_);
+    if ( "None" != autoDecompType_ ) {
+      HOFlowEnv::self().hoflowOutputP0() 
+        <<"Warning: When using automatic_decomposition_type, one must have a serial file" << std::endl;
+    }
+
+    // cache directory of the decomposed mesh and the linear system graphs
+    get_if_present(node, "mesh_cache", meshCacheDir_, meshCacheDir_);
+
 //    // activate aura
 //    get_if_present(node, "activate_aura", activateAura_, activateAura_);
 //    if ( activateAura_ )
@@ -239,12 +274,21 @@ void Realm::load(const YAML::Node & node) {
 //        get_if_present(y_time_step, "time_step_change_factor", timeStepChangeFactor_, timeStepChangeFactor_);
 //    }
 //
-//    get_if_present(node, "balance_nodes", doBalanceNodes_, doBalanceNodes_);
-//    get_if_present(node, "balance_nodes_iterations", balanceNodeOptions_.numIters, balanceNodeOptions_.numIters);
-//    get_if_present(node, "balance_nodes_target", balanceNodeOptions_.target, balanceNodeOptions_.target);
-//    if (node["balance_nodes_iterations"] || node["balance_nodes_target"] ) {
-//        doBalanceNodes_ = true;
-//    }
+
+    // runtime rebalancing by the measured assembly and solve cost
+    get_if_present(node, "balance_nodes", doBalanceNodes_, doBalanceNodes_);
+    get_if_present(node, "balance_nodes_iterations", balanceNodeOptions_.numIters, balanceNodeOptions_.numIters);
+    get_if_present(node, "balance_nodes_target", balanceNodeOptions_.target, balanceNodeOptions_.target);
+    get_if_present(node, "balance_nodes_frequency", balanceNodeOptions_.frequency, balanceNodeOptions_.frequency);
+    if (node["balance_nodes_iterations"] || node["balance_nodes_target"] || node["balance_nodes_frequency"] ) {
+        doBalanceNodes_ = true;
+    }
+    if ( doBalanceNodes_ ) {
+        if ( balanceNodeOptions_.frequency < 1 || balanceNodeOptions_.target < 1.0 )
+            throw std::runtime_error("Realm::load(): balance_nodes_frequency must be >= 1 and balance_nodes_target >= 1.0");
+        HOFlowEnv::self().hoflowOutputP0() << "HOFlow will rebalance when the cost max/avg exceeds "
+            << balanceNodeOptions_.target << " (checked every " << balanceNodeOptions_.frequency << " steps)" << std::endl;
+    }
 
 
     //======================================
@@ -254,6 +298,11 @@ void Realm::load(const YAML::Node & node) {
     // load output first so we can check for serializing i/o
     outputInfo_->load(node);
     solutionOptions_->load(node);
+    realmUsesEdges_ = solutionOptions_->useEdges_;
+    
+    // a restart reads its own database; the cache is keyed on the input mesh
+    if ( !meshCacheDir_.empty() && !restarted_simulation() )
+        meshCache_ = new MeshCache(HOFlowEnv::self().parallel_comm(), meshCacheDir_, inputDBName_, autoDecompType_);
     
     create_mesh();
     spatialDimension_ = metaData_->spatial_dimension();
@@ -282,6 +331,7 @@ void Realm::load(const YAML::Node & node) {
 //! Initializes the computational domain with in the input file specified values
 void Realm::initialize() {
     HOFlowEnv::self().hoflowOutputP0() << "Realm::initialize() Begin " << std::endl;
+    const double start_time = HOFlowEnv::self().hoflow_time();
     
     // field registration
     setup_nodal_fields();
@@ -300,6 +350,22 @@ void Realm::initialize() {
     // create initial conditions
     setup_initial_conditions();
     
+    // snapshots of the output and restart variables
+    if ( outputInfo_->hasOutputBlock_ && outputInfo_->outputAsync_ )
+        setup_output_fields();
+    if ( outputInfo_->hasRestartBlock_ )
+        setup_restart_fields();
+    
+    // element weights of the runtime rebalancing
+    if ( doBalanceNodes_ ) {
+        balanceWeight_ = &(metaData_->declare_field<ScalarFieldType>(stk::topology::ELEMENT_RANK, "balance_weight"));
+        stk::mesh::put_field_on_mesh(*balanceWeight_, metaData_->universal_part(), nullptr);
+    }
+
+    // part of the elements assembled before the shared rows are sent
+    if ( solutionOptions_->overlapSharedExport_ )
+        sharedElementPart_ = &metaData_->declare_part("hoflow_shared_elements", stk::topology::ELEMENT_RANK);
+    
     // Populate_mesh fills in the entities (nodes/elements/etc) and
     // connectivities, but no field-data. Field-data is not allocated yet.
     HOFlowEnv::self().hoflowOutputP0() << "Realm::ioBroker_->populate_mesh() Begin" << std::endl;
@@ -309,6 +375,14 @@ void Realm::initialize() {
     timerPopulateMesh_ += time;
     HOFlowEnv::self().hoflowOutputP0() << "Realm::ioBroker_->populate_mesh() End" << std::endl;
 
+    // edges for the edge-based assembly
+    if ( realmUsesEdges_ )
+        create_edges();
+
+    // split the element (and edge) buckets for the overlapped assembly
+    if ( solutionOptions_->overlapSharedExport_ )
+        mark_shared_elements();
+
     // output entity counts including max/min
     if ( provideEntityCount_ ) {
         provide_entity_count();
@@ -324,16 +398,36 @@ void Realm::initialize() {
     timerPopulateFieldData_ += time;
     HOFlowEnv::self().hoflowOutputP0() << "Realm::ioBroker_->populate_field_data() End" << std::endl;
     
+    // first run on this mesh and rank count; keep the decomposed mesh
+    if ( meshCache_ && solutionOptions_->inputVarFromFileMap_.empty() && !outputInfo_->activateRestart_ )
+        meshCache_->store_mesh(*ioBroker_);
+    
     // manage HOFlowGlobalId for linear system
     set_global_id();
     
     // output and restart files
     create_output_mesh();
+    create_restart_mesh();
     
     populate_boundary_data();
+    
+    // element geometry cache is filled by compute_geometry
+    if ( solutionOptions_->useElemGeometryCache_ )
+        elemGeometryCache_ = new ElemGeometryCache(*this);
+    
     compute_geometry();
     equationSystems_.initialize();
     check_job(false);
+
+    // startup time up to the assembled linear systems
+    const double startupTime = timerCreateMesh_ + HOFlowEnv::self().hoflow_time() - start_time;
+    double g_startupTime = 0.0;
+    stk::all_reduce_max(HOFlowEnv::self().parallel_comm(), &startupTime, &g_startupTime, 1);
+    HOFlowEnv::self().hoflowOutputP0() << "Startup time (max) = " << g_startupTime;
+    if ( meshCache_ )
+        HOFlowEnv::self().hoflowOutputP0() << ", mesh cache: mesh " << (meshFromCache_ ? "warm" : "cold")
+            << ", graphs " << meshCache_->num_hits() << " warm / " << meshCache_->num_misses() << " cold";
+    HOFlowEnv::self().hoflowOutputP0() << std::endl;
     HOFlowEnv::self().hoflowOutputP0() << "Realm::initialize() End " << std::endl;
 }
 
@@ -358,6 +452,71 @@ void Realm::setup_edge_fields() {
     equationSystems_.register_edge_fields(targetNames);
 }
 
+//! Creates the edges of all elements; needed by the edge-based algorithms
+void Realm::create_edges() {
+    HOFlowEnv::self().hoflowOutputP0() << "Realm::create_edges() Begin" << std::endl;
+    double time = -HOFlowEnv::self().hoflow_time();
+    stk::mesh::create_edges(*bulkData_, metaData_->universal_part());
+    time += HOFlowEnv::self().hoflow_time();
+    timerCreateEdges_ += time;
+    HOFlowEnv::self().hoflowOutputP0() << "Realm::create_edges() End" << std::endl;
+}
+
+//! Elements with a shared node feed the sharedNotOwned rows, elements with a
+//! bc node the Dirichlet and constraint rows; both are assembled first
+void Realm::mark_shared_elements() {
+    stk::mesh::Selector bcSelector = stk::mesh::selectUnion(bcPartVec_);
+    stk::mesh::BucketVector const & elem_buckets =
+            bulkData_->get_buckets(stk::topology::ELEMENT_RANK, metaData_->locally_owned_part());
+
+    std::vector<stk::mesh::Entity> sharedElements;
+    std::vector<stk::mesh::Entity> interiorElements;
+    size_t numElements = 0;
+    for ( const stk::mesh::Bucket * bptr : elem_buckets ) {
+        numElements += bptr->size();
+        const bool inPart = bptr->member(*sharedElementPart_);
+        for ( stk::mesh::Entity elem : *bptr ) {
+            bool shared = false;
+            const stk::mesh::Entity * nodes = bulkData_->begin_nodes(elem);
+            const unsigned numNodes = bulkData_->num_nodes(elem);
+            for ( unsigned n = 0; n < numNodes; ++n ) {
+                const stk::mesh::Bucket & nodeBucket = bulkData_->bucket(nodes[n]);
+                if ( nodeBucket.shared() || !nodeBucket.owned() || bcSelector(nodeBucket) ) {
+                    shared = true;
+                    break;
+                }
+            }
+            if ( shared && !inPart )
+                sharedElements.push_back(elem);
+            else if ( !shared && inPart )
+                interiorElements.push_back(elem);
+        }
+    }
+
+    // edges and nodes of the marked elements are induced members; after a
+    // rebalance, elements may also leave the part
+    stk::mesh::PartVector regionParts(1, sharedElementPart_);
+    stk::mesh::PartVector noParts;
+    bulkData_->modification_begin();
+    for ( stk::mesh::Entity elem : sharedElements )
+        bulkData_->change_entity_parts(elem, regionParts, noParts);
+    for ( stk::mesh::Entity elem : interiorElements )
+        bulkData_->change_entity_parts(elem, noParts, regionParts);
+    bulkData_->modification_end();
+
+    size_t numShared = 0;
+    const stk::mesh::BucketVector & shared_buckets = bulkData_->get_buckets(stk::topology::ELEMENT_RANK,
+        metaData_->locally_owned_part() & *sharedElementPart_);
+    for ( const stk::mesh::Bucket * bptr : shared_buckets )
+        numShared += bptr->size();
+
+    size_t localCounts[2] = {numShared, numElements};
+    size_t globalCounts[2] = {0, 0};
+    stk::all_reduce_sum(bulkData_->parallel(), localCounts, globalCounts, 2);
+    HOFlowEnv::self().hoflowOutputP0() << "Realm::mark_shared_elements() " << globalCounts[0]
+                                       << " of " << globalCounts[1] << " elements assembled before the shared row export" << std::endl;
+}
+
 void Realm::setup_element_fields() {
     // loop over all material props targets and register element fields
     std::vector<std::string> targetNames = get_physics_target_names();
@@ -502,6 +661,7 @@ void Realm::augment_property_map(PropertyIdentifier propID, ScalarFieldType *the
 
 void Realm::output_converged_results() {
     provide_output();
+    provide_restart_output();
 }
 
 void Realm::commit() {
@@ -512,6 +672,7 @@ void Realm::commit() {
 void Realm::create_mesh() {
     HOFlowEnv::self().hoflowOutputP0() << "Realm::create_mesh(): Begin" << std::endl;
     stk::ParallelMachine pm = HOFlowEnv::self().parallel_comm();
+    const double start_time = HOFlowEnv::self().hoflow_time();
 
     // news for mesh constructs
     metaData_ = new stk::mesh::MetaData();
@@ -519,10 +680,20 @@ void Realm::create_mesh() {
     ioBroker_ = new stk::io::StkMeshIoBroker( pm );
     ioBroker_->set_bulk_data(*bulkData_);
 
+    // set auto decomposition property; Ioss decomposes the serial file while reading.
+    // A cached mesh is already decomposed, one file per rank
+    const bool cachedMesh = use_cached_mesh();
+    meshFromCache_ = cachedMesh;
+    if ( "None" != autoDecompType_ && !cachedMesh ) {
+        ioBroker_->property_add(Ioss::Property("DECOMPOSITION_METHOD", autoDecompType_));
+    }
+
     // Initialize meta data (from exodus file); can possibly be a restart file..
-    inputMeshIdx_ = ioBroker_->add_mesh_database( inputDBName_, stk::io::READ_MESH );
+    inputMeshIdx_ = ioBroker_->add_mesh_database( cachedMesh ? meshCache_->mesh_file() : inputDBName_, stk::io::READ_MESH );
     ioBroker_->create_input_mesh();
 
+    timerCreateMesh_ += HOFlowEnv::self().hoflow_time() - start_time;
+
     HOFlowEnv::self().hoflowOutputP0() << "Realm::create_mesh() End" << std::endl;
 }
 
@@ -548,6 +719,14 @@ void Realm::create_output_mesh() {
             if (fileid++ > 0) oname += "-s" + fileid_ss.str();
         }
 
+        // a rebalanced mesh continues in a new file
+        if (numRebalances_ > 0) {
+            std::ostringstream balance_ss;
+            balance_ss << std::setfill('0') << std::setw(4) << numRebalances_;
+            oname += "-b" + balance_ss.str();
+            ioBroker_->close_output_mesh(resultsFileIndex_);
+        }
+
         if (!outputInfo_->catalystFileName_.empty()||!outputInfo_->paraviewScriptName_.empty()) {
             outputInfo_->outputPropertyManager_->add(Ioss::Property("CATALYST_BLOCK_PARSE_JSON_STRING",
                                                      outputInfo_->catalystParseJson_));
@@ -565,6 +744,7 @@ void Realm::create_output_mesh() {
         else {
             resultsFileIndex_ = ioBroker_->create_output_mesh( oname, stk::io::WRITE_RESULTS, *outputInfo_->outputPropertyManager_);
         }
+        outputStepsInFile_ = 0;
 
         // Tell stk_io how to output element block nodal fields:
         // if 'true' passed to function, then output them as nodeset fields;
@@ -584,16 +764,131 @@ void Realm::create_output_mesh() {
             else {
                 // 'varName' is the name that will be written to the database
                 // For now, just using the name of the stk field
-                ioBroker_->add_field(resultsFileIndex_, *theField, varName);
+                stk::mesh::FieldBase *outputField = theField;
+                for ( size_t k = 0; k < outputFields_.size(); ++k )
+                    if ( outputFields_[k].first == theField )
+                        outputField = outputFields_[k].second;
+                ioBroker_->add_field(resultsFileIndex_, *outputField, varName);
             }
         }
         // reset this flag
         outputInfo_->meshAdapted_ = false;
 
+        // the mesh definition communicates; written on the solver thread
+        if ( !outputFields_.empty() ) {
+            ioBroker_->write_output_mesh(resultsFileIndex_);
+            if ( NULL == outputWriter_ )
+                outputWriter_ = new AsyncOutputWriter();
+        }
+
         HOFlowEnv::self().hoflowOutputP0() << "Realm::create_output_mesh() End" << std::endl;
     }
 }
 
+//! Output variables are written from snapshot fields, so the solver can
+//! advance while a step is written
+void Realm::setup_output_fields() {
+    // catalyst processes the step in situ
+    if ( !outputInfo_->catalystFileName_.empty() || !outputInfo_->paraviewScriptName_.empty() ) {
+        HOFlowEnv::self().hoflowOutputP0() << "Realm::setup_output_fields(): asynchronous_write is not supported with catalyst" << std::endl;
+        return;
+    }
+
+    for ( std::set<std::string>::iterator itorSet = outputInfo_->outputFieldNameSet_.begin();
+        itorSet != outputInfo_->outputFieldNameSet_.end(); ++itorSet ) {
+        const std::string & varName = *itorSet;
+        stk::mesh::FieldBase *theField = stk::mesh::get_field_by_name(varName, *metaData_);
+        if ( NULL == theField )
+            continue;
+
+        GenericFieldType *snapshot = &(metaData_->declare_field<GenericFieldType>(
+            theField->entity_rank(), varName + "_output_snapshot"));
+
+        const stk::mesh::FieldRestrictionVector & restrictions = theField->restrictions();
+        for ( size_t r = 0; r < restrictions.size(); ++r )
+            stk::mesh::put_field_on_mesh(*snapshot, restrictions[r].selector(), restrictions[r].num_scalars_per_entity(), nullptr);
+
+        outputFields_.push_back(std::make_pair(theField, snapshot));
+    }
+}
+
+//! Restart variables are written from single state snapshot fields, so the
+//! solver can advance while a step is written; all states are kept
+void Realm::setup_restart_fields() {
+    const std::string stateSuffix[3] = {"", "_N", "_NM1"};
+
+    for ( std::set<std::string>::iterator itorSet = outputInfo_->restartFieldNameSet_.begin();
+        itorSet != outputInfo_->restartFieldNameSet_.end(); ++itorSet ) {
+        const std::string & varName = *itorSet;
+        stk::mesh::FieldBase *theField = stk::mesh::get_field_by_name(varName, *metaData_);
+        if ( NULL == theField ) {
+            HOFlowEnv::self().hoflowOutputP0() << " Sorry, no field by the name " << varName << std::endl;
+            continue;
+        }
+
+        const unsigned numStates = std::min(theField->number_of_states(), 3u);
+        for ( unsigned s = 0; s < numStates; ++s ) {
+            stk::mesh::FieldBase *stateField = theField->field_state(static_cast<stk::mesh::FieldState>(s));
+            GenericFieldType *snapshot = &(metaData_->declare_field<GenericFieldType>(
+                stateField->entity_rank(), varName + stateSuffix[s] + "_restart_snapshot"));
+
+            const stk::mesh::FieldRestrictionVector & restrictions = stateField->restrictions();
+            for ( size_t r = 0; r < restrictions.size(); ++r )
+                stk::mesh::put_field_on_mesh(*snapshot, restrictions[r].selector(), restrictions[r].num_scalars_per_entity(), nullptr);
+
+            RestartField restartField = {stateField, snapshot, varName + stateSuffix[s]};
+            restartFields_.push_back(restartField);
+        }
+    }
+}
+
+void Realm::create_restart_mesh() {
+    if ( !outputInfo_->hasRestartBlock_ )
+        return;
+
+    HOFlowEnv::self().hoflowOutputP0() << "Realm::create_restart_mesh(): Begin" << std::endl;
+
+    // a rebalanced mesh continues in a new file
+    std::string rname = outputInfo_->restartDBName_;
+    if ( numRebalances_ > 0 ) {
+        std::ostringstream balance_ss;
+        balance_ss << std::setfill('0') << std::setw(4) << numRebalances_;
+        rname += "-b" + balance_ss.str();
+        ioBroker_->close_output_mesh(restartFileIndex_);
+    }
+
+    restartFileIndex_ = ioBroker_->create_output_mesh(rname, stk::io::WRITE_RESTART,
+                                                      *outputInfo_->restartPropertyManager_);
+    restartStepsInFile_ = 0;
+    ioBroker_->use_nodeset_for_part_nodes_fields(restartFileIndex_, outputInfo_->restartNodeSet_);
+    ioBroker_->set_max_num_steps_before_overwrite(restartFileIndex_, outputInfo_->restartMaxDataBaseStepSize_);
+
+    for ( size_t k = 0; k < restartFields_.size(); ++k )
+        ioBroker_->add_field(restartFileIndex_, *restartFields_[k].snapshotField_, restartFields_[k].dbName_);
+
+    ioBroker_->add_global(restartFileIndex_, "timeStepNm1", Ioss::Field::REAL);
+    ioBroker_->add_global(restartFileIndex_, "timeStepCount", Ioss::Field::INTEGER);
+
+    // the mesh definition communicates; written on the solver thread
+    ioBroker_->write_output_mesh(restartFileIndex_);
+
+    if ( outputInfo_->restartAsync_ && NULL == outputWriter_ )
+        outputWriter_ = new AsyncOutputWriter();
+
+    HOFlowEnv::self().hoflowOutputP0() << "Realm::create_restart_mesh() End" << std::endl;
+}
+
+void Realm::copy_restart_fields(bool toSnapshot) {
+    for ( size_t k = 0; k < restartFields_.size(); ++k ) {
+        const RestartField & restartField = restartFields_[k];
+        const stk::mesh::Selector s_snapshot = stk::mesh::selectField(*restartField.snapshotField_);
+        if ( toSnapshot )
+            stk::mesh::field_copy(*restartField.stateField_, *restartField.snapshotField_, s_snapshot);
+        else
+            stk::mesh::field_copy(*restartField.snapshotField_, *restartField.stateField_, s_snapshot);
+    }
+}
+
 void Realm::input_variables_from_mesh() {
     /*// check whether to snap or interpolate data; all fields treated the same
     const stk::io::MeshField::TimeMatchOption fieldInterpOption = solutionOptions_->inputVariablesInterpolateInTime_
@@ -731,12 +1026,100 @@ void Realm::provide_output() {
                 HOFlowEnv::self().hoflowOutputP0() << "Realm shall provide output files at : currentTime/timeStepCount: "
                                                    << currentTime << "/" <<  timeStepCount << " (" << name_ << ")" << std::endl;   
             }
-            // not set up for globals
-            ioBroker_->process_output_request(resultsFileIndex_, currentTime);
+            // not set up for globals; Ioss is not thread safe
+            if ( NULL != outputWriter_ )
+                outputWriter_->wait();
+            // the previous step no longer reads the snapshots
+            for ( size_t k = 0; k < outputFields_.size(); ++k )
+                stk::mesh::field_copy(*outputFields_[k].first, *outputFields_[k].second,
+                                      stk::mesh::selectField(*outputFields_[k].second));
+            // the first step defines the transient fields with MPI calls; only
+            // the steps after it go to the writer thread (MPI_THREAD_FUNNELED)
+            if ( !outputFields_.empty() && outputStepsInFile_ > 0 ) {
+                const size_t resultsFileIndex = resultsFileIndex_;
+                stk::io::StkMeshIoBroker *ioBroker = ioBroker_;
+                outputWriter_->submit([ioBroker, resultsFileIndex, currentTime]() {
+                    ioBroker->process_output_request(resultsFileIndex, currentTime);
+                });
+            }
+            else {
+                ioBroker_->process_output_request(resultsFileIndex_, currentTime);
+            }
+            outputStepsInFile_ += 1;
             
             equationSystems_.provide_output();
+
+            // time the solver spends on the step; with asynchronous_write only the stall
+            timerOutputFields_ += HOFlowEnv::self().hoflow_time() - start_time;
+            numOutputSteps_ += 1;
+        }
+    }
+}
+
+void Realm::provide_restart_output() {
+    // restart needs the time step count of the time integrator
+    if ( !outputInfo_->hasRestartBlock_ || simType_ != "transient" )
+        return;
+
+    const double currentTime = get_current_time();
+    const int timeStepCount = get_time_step_count();
+    const int modStep = timeStepCount - outputInfo_->restartStart_;
+
+    // check for elapsed WALL time threshold
+    bool forcedOutput = false;
+    if ( outputInfo_->userWallTimeRestart_.first ) {
+        const double elapsedWallTime = stk::wall_time() - wallTimeStart_;
+        double g_elapsedWallTime = 0.0;
+        stk::all_reduce_max(HOFlowEnv::self().parallel_comm(), &elapsedWallTime, &g_elapsedWallTime, 1);
+        g_elapsedWallTime /= 3600.0;
+        // only force restart the first time the timer is exceeded
+        if ( g_elapsedWallTime > outputInfo_->userWallTimeRestart_.second ) {
+            forcedOutput = true;
+            outputInfo_->userWallTimeRestart_.first = false;
+            HOFlowEnv::self().hoflowOutputP0() << "Realm::provide_restart_output()::Forced restart output will be processed at current time: "
+                                               << currentTime << std::endl;
         }
     }
+
+    const bool isRestart = (timeStepCount >= outputInfo_->restartStart_ && modStep % outputInfo_->restartFreq_ == 0) || forcedOutput;
+    if ( !isRestart )
+        return;
+
+    HOFlowEnv::self().hoflowOutputP0() << "Realm shall provide restart files at : currentTime/timeStepCount: "
+                                       << currentTime << "/" << timeStepCount << " (" << name_ << ")" << std::endl;
+
+    // solver thread stall; the previous step still reads the snapshots
+    const double timeA = HOFlowEnv::self().hoflow_time();
+    if ( NULL != outputWriter_ )
+        outputWriter_->wait();
+    copy_restart_fields(true);
+
+    // the step just completed is the nm1 step of the restarted run
+    const double timeStepNm1 = get_time_step();
+    const size_t restartFileIndex = restartFileIndex_;
+    stk::io::StkMeshIoBroker *ioBroker = ioBroker_;
+    auto writeStep = [ioBroker, restartFileIndex, currentTime, timeStepNm1, timeStepCount]() {
+        ioBroker->begin_output_step(restartFileIndex, currentTime);
+        ioBroker->write_defined_output_fields(restartFileIndex);
+        ioBroker->write_global(restartFileIndex, "timeStepNm1", timeStepNm1);
+        ioBroker->write_global(restartFileIndex, "timeStepCount", timeStepCount);
+        ioBroker->end_output_step(restartFileIndex);
+    };
+
+    // the step that defines the transient fields makes MPI calls; only the
+    // steps after it go to the writer thread (MPI_THREAD_FUNNELED)
+    const int stepsBeforeOverwrite = std::max(outputInfo_->restartMaxDataBaseStepSize_, 1);
+    const bool defineStep = 0 == restartStepsInFile_ % stepsBeforeOverwrite;
+    if ( outputInfo_->restartAsync_ && !defineStep )
+        outputWriter_->submit(writeStep);
+    else
+        writeStep();
+    restartStepsInFile_ += 1;
+
+    const double stall = HOFlowEnv::self().hoflow_time() - timeA;
+    timerRestartStall_ += stall;
+    maxRestartStall_ = std::max(maxRestartStall_, stall);
+    numRestartSteps_ += 1;
 }
 
 void Realm::set_global_id()
@@ -858,10 +1241,17 @@ const stk::mesh::MetaData & Realm::meta_data() const
     return *metaData_;
 }
 
+//! The decomposed mesh of a previous run is read instead of the input mesh;
+//! not with input variables or on a restarted run, the cached mesh has no fields
+bool Realm::use_cached_mesh() const
+{
+    return meshCache_ && meshCache_->has_mesh() && solutionOptions_->inputVarFromFileMap_.empty()
+        && !outputInfo_->activateRestart_;
+}
+
 bool Realm::restarted_simulation()
 {
-//  return outputInfo_->activateRestart_ ;
-    return false; //temp soluition
+    return outputInfo_->activateRestart_;
 }
 
 bool Realm::support_inconsistent_restart()
@@ -901,6 +1291,14 @@ stk::mesh::Selector Realm::get_inactive_selector() {
     return inactiveOverSetSelector | otherInactiveSelector;
 }
 
+stk::mesh::Selector Realm::assembly_region_selector(AssemblyRegion region) {
+    if ( sharedElementPart_ == NULL || region == ASSEMBLE_ALL )
+        return metaData_->universal_part();
+    if ( region == ASSEMBLE_SHARED )
+        return *sharedElementPart_;
+    return !(*sharedElementPart_);
+}
+
 void Realm::push_equation_to_systems(EquationSystem * eqSystem){
     equationSystems_.equationSystemVector_.push_back(eqSystem);
 }
@@ -982,6 +1380,10 @@ void Realm::check_job(bool get_node_count) {
   HOFlowEnv::self().hoflowOutputP0() << "Total memory estimate (per core) = "
                   << double(memoryEstimate)/procGBScale << " GB." << std::endl;
 
+  // the mesh is populated in the second review
+  if (!get_node_count && metaData_->is_commit())
+    check_decomposition();
+
   if (metaData_->is_commit() && estimateMemoryOnly_) {
     throw std::runtime_error("Job requested memory estimate only, shutting down");
   }
@@ -997,6 +1399,176 @@ void Realm::check_job(bool get_node_count) {
     }
 }
 
+void
+Realm::check_decomposition() {
+  HOFlowEnv::self().hoflowOutputP0() << std::endl;
+  HOFlowEnv::self().hoflowOutputP0() << "Realm decomposition Review: " << name_ << std::endl;
+  HOFlowEnv::self().hoflowOutputP0() << "===========================" << std::endl;
+
+  stk::ParallelMachine comm = HOFlowEnv::self().parallel_comm();
+  const int nprocs = HOFlowEnv::self().parallel_size();
+  const int myRank = bulkData_->parallel_rank();
+
+  // read (and decompose) the mesh
+  const double loadTime = timerCreateMesh_ + timerPopulateMesh_ + timerPopulateFieldData_;
+  double g_loadTime = 0.0;
+  stk::all_reduce_max(comm, &loadTime, &g_loadTime, 1);
+  HOFlowEnv::self().hoflowOutputP0() << "Decomposition: " << autoDecompType_
+                  << ", load time (max) = " << g_loadTime << std::endl;
+
+  // owned elements, owned nodes, owned nodes shared with other ranks, owned edges between ranks
+  const stk::mesh::Selector s_owned = metaData_->locally_owned_part();
+  size_t localCount[4] = {0, 0, 0, 0};
+  const stk::mesh::BucketVector & elem_buckets = bulkData_->get_buckets(stk::topology::ELEMENT_RANK, s_owned);
+  for ( stk::mesh::BucketVector::const_iterator ib = elem_buckets.begin(); ib != elem_buckets.end(); ++ib )
+    localCount[0] += (*ib)->size();
+
+  const stk::mesh::BucketVector & node_buckets = bulkData_->get_buckets(stk::topology::NODE_RANK, s_owned);
+  for ( stk::mesh::BucketVector::const_iterator ib = node_buckets.begin(); ib != node_buckets.end(); ++ib ) {
+    const stk::mesh::Bucket & b = **ib;
+    localCount[1] += b.size();
+    if ( b.shared() )
+      localCount[2] += b.size();
+  }
+
+  if ( realmUsesEdges_ ) {
+    const stk::mesh::BucketVector & edge_buckets = bulkData_->get_buckets(stk::topology::EDGE_RANK, s_owned);
+    for ( stk::mesh::BucketVector::const_iterator ib = edge_buckets.begin(); ib != edge_buckets.end(); ++ib ) {
+      const stk::mesh::Bucket & b = **ib;
+      for ( size_t k = 0; k < b.size(); ++k ) {
+        const stk::mesh::Entity * edge_nodes = b.begin_nodes(k);
+        if ( bulkData_->parallel_owner_rank(edge_nodes[0]) != myRank
+             || bulkData_->parallel_owner_rank(edge_nodes[1]) != myRank )
+          localCount[3] += 1;
+      }
+    }
+  }
+
+  size_t g_minCount[4] = {}, g_maxCount[4] = {}, g_sumCount[4] = {};
+  stk::all_reduce_min(comm, &localCount[0], &g_minCount[0], 4);
+  stk::all_reduce_max(comm, &localCount[0], &g_maxCount[0], 4);
+  stk::all_reduce_sum(comm, &localCount[0], &g_sumCount[0], 4);
+
+  const std::string countName[2] = {"elements", "nodes"};
+  for ( int k = 0; k < 2; ++k ) {
+    const double avg = double(g_sumCount[k])/double(nprocs);
+    HOFlowEnv::self().hoflowOutputP0() << "Owned " << countName[k] << " per rank: min: " << g_minCount[k]
+                    << " avg: " << avg << " max: " << g_maxCount[k]
+                    << " imbalance (max/avg): " << (avg > 0.0 ? double(g_maxCount[k])/avg : 1.0) << std::endl;
+  }
+  HOFlowEnv::self().hoflowOutputP0() << "Shared nodes: " << g_sumCount[2] << " (max per rank: " << g_maxCount[2] << ")" << std::endl;
+  if ( realmUsesEdges_ )
+    HOFlowEnv::self().hoflowOutputP0() << "Edge cut: " << g_sumCount[3] << " (max per rank: " << g_maxCount[3] << ")" << std::endl;
+}
+
+void
+Realm::balance_nodes() {
+  if ( !doBalanceNodes_ || simType_ != "transient" || numRebalances_ >= balanceNodeOptions_.numIters )
+    return;
+  if ( get_time_step_count() % balanceNodeOptions_.frequency != 0 )
+    return;
+
+  // measured cost since the last check; dump_eq_time resets the equation timers
+  double assembleTime = 0.0, solveTime = 0.0;
+  for ( EquationSystem *eqSys : equationSystems_.equationSystemVector_ ) {
+    assembleTime += eqSys->timerAssemble_ + eqSys->timerLoadComplete_;
+    solveTime += eqSys->timerSolve_;
+  }
+  const double deltaAssemble = assembleTime >= balanceAssembleTime_ ? assembleTime - balanceAssembleTime_ : assembleTime;
+  const double deltaSolve = solveTime >= balanceSolveTime_ ? solveTime - balanceSolveTime_ : solveTime;
+  balanceAssembleTime_ = assembleTime;
+  balanceSolveTime_ = solveTime;
+
+  const double cost = deltaAssemble + deltaSolve;
+  double g_maxCost = 0.0, g_sumCost = 0.0;
+  stk::all_reduce_max(HOFlowEnv::self().parallel_comm(), &cost, &g_maxCost, 1);
+  stk::all_reduce_sum(HOFlowEnv::self().parallel_comm(), &cost, &g_sumCost, 1);
+  const double avgCost = g_sumCost/double(HOFlowEnv::self().parallel_size());
+  const double imbalance = avgCost > 0.0 ? g_maxCost/avgCost : 1.0;
+
+  HOFlowEnv::self().hoflowOutputP0() << "Realm::balance_nodes() assembly and solve cost max/avg: " << imbalance
+                                     << " (target: " << balanceNodeOptions_.target << ")" << std::endl;
+  if ( imbalance > balanceNodeOptions_.target )
+    rebalance_mesh(deltaAssemble, deltaSolve);
+}
+
+void
+Realm::rebalance_mesh(const double assembleTime, const double solveTime) {
+  HOFlowEnv::self().hoflowOutputP0() << "Realm::rebalance_mesh() Begin" << std::endl;
+  const double start_time = HOFlowEnv::self().hoflow_time();
+
+  // the writer thread reads the snapshot fields and the old output databases
+  if ( NULL != outputWriter_ )
+    outputWriter_->wait();
+
+  compute_balance_weights(assembleTime, solveTime);
+  stk::balance::FieldVertexWeightSettings balanceSettings(*bulkData_, *balanceWeight_, 0.0);
+  stk::balance::balanceStkMesh(balanceSettings, *bulkData_);
+  numRebalances_ += 1;
+
+  // everything that depends on the owned entities
+  if ( solutionOptions_->overlapSharedExport_ )
+    mark_shared_elements();
+  if ( NULL != elemGeometryCache_ )
+    elemGeometryCache_->invalidate();
+  compute_geometry();
+  equationSystems_.reinitialize_linear_system();
+
+  // the output databases hold the old decomposition; continue in new files
+  create_output_mesh();
+  create_restart_mesh();
+
+  timerRebalance_ += HOFlowEnv::self().hoflow_time() - start_time;
+  HOFlowEnv::self().hoflowOutputP0() << "Realm::rebalance_mesh() End" << std::endl;
+
+  check_decomposition();
+}
+
+void
+Realm::compute_balance_weights(const double assembleTime, const double solveTime) {
+  const stk::mesh::Selector s_owned = metaData_->locally_owned_part();
+  const int myRank = bulkData_->parallel_rank();
+
+  // assembly is charged by element node, the solve by owned row
+  size_t localCount[2] = {0, 0};
+  const stk::mesh::BucketVector & elem_buckets = bulkData_->get_buckets(stk::topology::ELEMENT_RANK, s_owned);
+  for ( stk::mesh::BucketVector::const_iterator ib = elem_buckets.begin(); ib != elem_buckets.end(); ++ib )
+    localCount[0] += (*ib)->size()*(*ib)->topology().num_nodes();
+  const stk::mesh::BucketVector & node_buckets = bulkData_->get_buckets(stk::topology::NODE_RANK, s_owned);
+  for ( stk::mesh::BucketVector::const_iterator ib = node_buckets.begin(); ib != node_buckets.end(); ++ib )
+    localCount[1] += (*ib)->size();
+
+  const double assemblePerNode = localCount[0] > 0 ? assembleTime/double(localCount[0]) : 0.0;
+  const double solvePerRow = localCount[1] > 0 ? solveTime/double(localCount[1]) : 0.0;
+
+  // the partitioner sees relative weights; keep them O(100) per element
+  size_t numElements = 0;
+  for ( stk::mesh::BucketVector::const_iterator ib = elem_buckets.begin(); ib != elem_buckets.end(); ++ib )
+    numElements += (*ib)->size();
+  const double cost = assembleTime + solveTime;
+  size_t g_numElements = 0;
+  double g_cost = 0.0;
+  stk::all_reduce_sum(HOFlowEnv::self().parallel_comm(), &numElements, &g_numElements, 1);
+  stk::all_reduce_sum(HOFlowEnv::self().parallel_comm(), &cost, &g_cost, 1);
+  const double scale = g_cost > 0.0 ? 100.0*double(g_numElements)/g_cost : 1.0;
+
+  for ( stk::mesh::BucketVector::const_iterator ib = elem_buckets.begin(); ib != elem_buckets.end(); ++ib ) {
+    const stk::mesh::Bucket & b = **ib;
+    double * weight = stk::mesh::field_data(*balanceWeight_, b);
+    const unsigned numNodes = b.topology().num_nodes();
+    for ( size_t k = 0; k < b.size(); ++k ) {
+      // each owned row is split over the elements of its node
+      double w = assemblePerNode*numNodes;
+      const stk::mesh::Entity * elem_nodes = b.begin_nodes(k);
+      for ( unsigned n = 0; n < numNodes; ++n ) {
+        if ( bulkData_->parallel_owner_rank(elem_nodes[n]) == myRank )
+          w += solvePerRow/double(bulkData_->num_elements(elem_nodes[n]));
+      }
+      weight[k] = scale*w;
+    }
+  }
+}
+
 void
 Realm::provide_entity_count() {
 
@@ -1018,6 +1590,9 @@ Realm::provide_entity_count() {
 void
 Realm::pre_timestep_work()
 {
+  // runtime rebalancing by the measured cost
+  balance_nodes();
+
   // ask the equation system to do some work
   equationSystems_.pre_timestep_work();
 }
@@ -1036,9 +1611,10 @@ Realm::dump_simulation_time()
   const int nprocs = HOFlowEnv::self().parallel_size();
 
   // common
-  const unsigned ntimers = 6;
+  const unsigned ntimers = 7;
   double total_time[ntimers] = {timerCreateMesh_, timerOutputFields_, timerInitializeEqs_, 
-                                timerPropertyEval_, timerPopulateMesh_, timerPopulateFieldData_ };
+                                timerPropertyEval_, timerPopulateMesh_, timerPopulateFieldData_,
+                                timerCreateEdges_ };
   double g_min_time[ntimers] = {}, g_max_time[ntimers] = {}, g_total_time[ntimers] = {};
 
   // get min, max and sum over processes
@@ -1051,6 +1627,10 @@ Realm::dump_simulation_time()
                   << " \tmin: " << g_min_time[0] << " \tmax: " << g_max_time[0] << std::endl;
   HOFlowEnv::self().hoflowOutputP0() << " io output fields --  " << " \tavg: " << g_total_time[1]/double(nprocs)
                   << " \tmin: " << g_min_time[1] << " \tmax: " << g_max_time[1] << std::endl;
+  if ( numOutputSteps_ > 0 )
+    HOFlowEnv::self().hoflowOutputP0() << " io output/step   --  " << " \tavg: " << g_total_time[1]/double(nprocs*numOutputSteps_)
+                    << " \tmax: " << g_max_time[1]/double(numOutputSteps_)
+                    << (outputFields_.empty() ? " (synchronous)" : " (asynchronous_write)") << std::endl;
   HOFlowEnv::self().hoflowOutputP0() << " io populate mesh --  " << " \tavg: " << g_total_time[4]/double(nprocs)
                   << " \tmin: " << g_min_time[4] << " \tmax: " << g_max_time[4] << std::endl;
   HOFlowEnv::self().hoflowOutputP0() << " io populate fd   --  " << " \tavg: " << g_total_time[5]/double(nprocs)
@@ -1058,6 +1638,9 @@ Realm::dump_simulation_time()
   HOFlowEnv::self().hoflowOutputP0() << "Timing for connectivity/finalize lysys: " << std::endl;
   HOFlowEnv::self().hoflowOutputP0() << "         eqs init --  " << " \tavg: " << g_total_time[2]/double(nprocs)
                   << " \tmin: " << g_min_time[2] << " \tmax: " << g_max_time[2] << std::endl;
+  if ( realmUsesEdges_ )
+    HOFlowEnv::self().hoflowOutputP0() << "     create edges --  " << " \tavg: " << g_total_time[6]/double(nprocs)
+                    << " \tmin: " << g_min_time[6] << " \tmax: " << g_max_time[6] << std::endl;
 
   HOFlowEnv::self().hoflowOutputP0() << "Timing for property evaluation:         " << std::endl;
   HOFlowEnv::self().hoflowOutputP0() << "            props --  " << " \tavg: " << g_total_time[3]/double(nprocs)
@@ -1075,6 +1658,26 @@ Realm::dump_simulation_time()
                                    << " \tmin: " << g_minSort<< " \tmax: " << g_maxSort<< std::endl;
   }
 
+  // runtime rebalancing
+  if ( numRebalances_ > 0 ) {
+    double g_maxRebalance = 0.0;
+    stk::all_reduce_max(HOFlowEnv::self().parallel_comm(), &timerRebalance_, &g_maxRebalance, 1);
+    HOFlowEnv::self().hoflowOutputP0() << "Timing for rebalance (" << numRebalances_ << " rebalances): " << std::endl;
+    HOFlowEnv::self().hoflowOutputP0() << "        rebalance --  " << " \tmax: " << g_maxRebalance << std::endl;
+  }
+
+  // solver thread stall per restart step; the writes overlap the time loop
+  if ( numRestartSteps_ > 0 ) {
+    const double avgStall = timerRestartStall_/double(numRestartSteps_);
+    double g_avgStall = 0.0, g_maxStall = 0.0;
+    stk::all_reduce_max(HOFlowEnv::self().parallel_comm(), &avgStall, &g_avgStall, 1);
+    stk::all_reduce_max(HOFlowEnv::self().parallel_comm(), &maxRestartStall_, &g_maxStall, 1);
+
+    HOFlowEnv::self().hoflowOutputP0() << "Timing for restart output (" << numRestartSteps_ << " steps): " << std::endl;
+    HOFlowEnv::self().hoflowOutputP0() << "    restart stall --  " << " \tavg/step: " << g_avgStall
+                                   << " \tmax/step: " << g_maxStall << std::endl;
+  }
+
   HOFlowEnv::self().hoflowOutputP0() << std::endl;
 }
 
@@ -1116,6 +1719,21 @@ Realm::provide_memory_summary()
                                   << std::setw(15) << convert_bytes(global_now[1])
                                   << std::setw(15) << convert_bytes(global_hwm[1])
                                   << std::endl;
+
+  // element geometry cache; memory paid for not recomputing the geometry during assembly
+  if ( NULL != elemGeometryCache_ ) {
+    size_t cacheBytes[2] = {elemGeometryCache_->memory_bytes(), elemGeometryCache_->num_elements()};
+    double buildTime = elemGeometryCache_->timerBuild_;
+    stk::all_reduce(HOFlowEnv::self().parallel_comm(), stk::ReduceSum<2>( &cacheBytes[0] ) );
+    stk::all_reduce(HOFlowEnv::self().parallel_comm(), stk::ReduceMax<1>( &buildTime ) );
+
+    const double bytesPerElem = cacheBytes[1] > 0 ? double(cacheBytes[0])/double(cacheBytes[1]) : 0.0;
+    HOFlowEnv::self().hoflowOutputP0() << "HOFlow memory: element geometry cache (over all cores)=      "
+                                   << std::setw(15) << convert_bytes(cacheBytes[0])
+                                   << " for " << cacheBytes[1] << " elements ("
+                                   << bytesPerElem << " bytes/element), build time (max)= "
+                                   << buildTime << std::endl;
+  }
 }
 
 //--------------------------------------------------------------------------
@@ -1202,6 +1820,12 @@ Realm::get_time_step_count() const
 void
 Realm::compute_geometry()
 {
+  // element geometry cache first so that the interior algorithm can use it;
+  // a moving mesh has new coordinates each time we get here
+  if ( NULL != elemGeometryCache_ 
+       && ( solutionOptions_->does_mesh_move() || !elemGeometryCache_->is_valid() ) )
+    elemGeometryCache_->build();
+
   // interior and boundary
   computeGeometryAlgDriver_->execute();
 }
@@ -1269,6 +1893,39 @@ Realm::populate_variables_from_input(const double currentTime)
   return foundTime;
 }
 
+//--------------------------------------------------------------------------
+//-------- populate_restart ------------------------------------------------
+//--------------------------------------------------------------------------
+double
+Realm::populate_restart(double & timeStepNm1, int & timeStepCount)
+{
+  double foundRestartTime = get_current_time();
+  if ( restarted_simulation() ) {
+    // the restart database is the input mesh; all states come back through the snapshots
+    for ( size_t k = 0; k < restartFields_.size(); ++k ) {
+      ioBroker_->add_input_field(stk::io::MeshField(*restartFields_[k].snapshotField_, restartFields_[k].dbName_));
+    }
+
+    std::vector<stk::io::MeshField> missingFields;
+    foundRestartTime = ioBroker_->read_defined_input_fields(outputInfo_->restartTime_, &missingFields);
+    if ( missingFields.size() > 0 ) {
+      for ( size_t k = 0; k < missingFields.size(); ++k) {
+        HOFlowEnv::self().hoflowOutputP0() << "ERROR: Realm::populate_restart for field "
+            << missingFields[k].db_name() << " is missing on " << inputDBName_ << std::endl;
+      }
+      throw std::runtime_error("Realm::populate_restart(): restart variables are missing");
+    }
+    copy_restart_fields(false);
+
+    ioBroker_->get_global("timeStepNm1", timeStepNm1);
+    ioBroker_->get_global("timeStepCount", timeStepCount);
+
+    HOFlowEnv::self().hoflowOutputP0() << "Realm::populate_restart() restart time/timeStepCount: "
+        << foundRestartTime << "/" << timeStepCount << " for Realm: " << name() << std::endl;
+  }
+  return foundRestartTime;
+}
+
 //--------------------------------------------------------------------------
 //-------- populate_derived_quantities -------------------------------------
 //--------------------------------------------------------------------------
@@ -71,6 +71,15 @@ SolutionOptions::SolutionOptions()
     consistentMMPngDefault_(false),
     useConsolidatedSolverAlg_(false),
     useConsolidatedBcSolverAlg_(false),
+    useElementColoring_(false),
+    useElemGeometryCache_(false),
+    reuseConstantLhs_(false),
+    useScatterPlan_(false),
+    useEdges_(false),
+    fuseNodalGradient_(false),
+    staticGraphAssembly_(false),
+    overlapSharedExport_(false),
+    nodeReordering_("none"),
     eigenvaluePerturb_(false),
     eigenvaluePerturbDelta_(0.0),
     eigenvaluePerturbBiasTowards_(3),
@@ -129,6 +138,35 @@ void SolutionOptions::load(const YAML::Node & y_node) {
         // check for consolidated face-elem bc alg
         get_if_present(y_solution_options, "use_consolidated_face_elem_bc_algorithm", useConsolidatedBcSolverAlg_, useConsolidatedBcSolverAlg_);
 
+        // colour elements so that the consolidated elem alg can assemble without atomics
+        get_if_present(y_solution_options, "use_element_coloring", useElementColoring_, useElementColoring_);
+
+        // store scs_areav, dndx and scv_volume per element instead of recomputing them during assembly
+        get_if_present(y_solution_options, "use_element_geometry_cache", useElemGeometryCache_, useElemGeometryCache_);
+
+        // assemble a constant LHS (constant properties, static mesh, fixed dt) only once
+        get_if_present(y_solution_options, "reuse_constant_lhs", reuseConstantLhs_, reuseConstantLhs_);
+
+        // store the matrix value offsets of every element lhs entry; sumInto then needs no sort or search
+        get_if_present(y_solution_options, "use_scatter_plan", useScatterPlan_, useScatterPlan_);
+
+        // edge-based diffusion assembly from a precomputed edge area vector; linear tets and triangles
+        get_if_present(y_solution_options, "use_edges", useEdges_, useEdges_);
+
+        // compute the Green-Gauss nodal gradient in the element diffusion sweep instead of a second pass
+        get_if_present(y_solution_options, "fuse_nodal_gradient", fuseNodalGradient_, fuseNodalGradient_);
+
+        // keep the matrices on their static graphs fill complete between assemblies
+        get_if_present(y_solution_options, "static_graph_assembly", staticGraphAssembly_, staticGraphAssembly_);
+
+        // assemble the interior elements while the shared rows are sent to their owners
+        get_if_present(y_solution_options, "overlap_shared_export", overlapSharedExport_, overlapSharedExport_);
+
+        // local order of the linear system rows; none, rcm or hilbert
+        get_if_present(y_solution_options, "node_reordering", nodeReordering_, nodeReordering_);
+        if ( nodeReordering_ != "none" && nodeReordering_ != "rcm" && nodeReordering_ != "hilbert" )
+            throw std::runtime_error("node_reordering must be none, rcm or hilbert");
+
         // eigenvalue purturbation; over all dofs...
         get_if_present(y_solution_options, "eigenvalue_perturbation", eigenvaluePerturb_);
         get_if_present(y_solution_options, "eigenvalue_perturbation_delta", eigenvaluePerturbDelta_);
@@ -29,7 +29,8 @@ SolverAlgorithm::SolverAlgorithm(
   stk::mesh::Part *part,
   EquationSystem *eqSystem)
   : Algorithm(realm, part),
-    eqSystem_(eqSystem)
+    eqSystem_(eqSystem),
+    region_(ASSEMBLE_ALL)
 {
   // nothing to do
 }
@@ -59,4 +60,30 @@ SolverAlgorithm::apply_coeff(
   const char *trace_tag)
 {
   eqSystem_->linsys_->sumInto(numMeshobjs, symMeshobjs, rhs, lhs, scratchIds, sortPermutation, trace_tag);
+}
+
+void
+SolverAlgorithm::apply_coeff(
+  stk::mesh::Entity elem,
+  const std::vector<stk::mesh::Entity> & sym_meshobj,
+  std::vector<int> &scratchIds,
+  std::vector<double> &scratchVals,
+  const std::vector<double> & rhs,
+  const std::vector<double> & lhs, const char *trace_tag)
+{
+  eqSystem_->linsys_->sumInto(elem, sym_meshobj, scratchIds, scratchVals, rhs, lhs, trace_tag);
+}
+
+void
+SolverAlgorithm::apply_coeff(
+  stk::mesh::Entity elem,
+  unsigned numMeshobjs,
+  const stk::mesh::Entity* symMeshobjs,
+  const SharedMemView<int*> & scratchIds,
+  const SharedMemView<int*> & sortPermutation,
+  const SharedMemView<const double*> & rhs,
+  const SharedMemView<const double**> & lhs,
+  const char *trace_tag)
+{
+  eqSystem_->linsys_->sumInto(elem, numMeshobjs, symMeshobjs, rhs, lhs, scratchIds, sortPermutation, trace_tag);
 }
\ No newline at end of file
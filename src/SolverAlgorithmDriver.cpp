@@ -7,6 +7,7 @@
 #include <AlgorithmDriver.h>
 #include <Enums.h>
 #include <SolverAlgorithm.h>
+#include <LinearSystem.h>
 
 class Realm;
 
@@ -62,6 +63,54 @@ void SolverAlgorithmDriver::pre_work() {
     // might set initial guess
 }
 
+void SolverAlgorithmDriver::execute_overlapped(LinearSystem & linsys) {
+    pre_work();
+
+    // shared elements of the split algorithms; all of the others
+    std::map<std::string, SolverAlgorithm *>::iterator itc;
+    for ( itc = solverAlgorithmMap_.begin(); itc != solverAlgorithmMap_.end(); ++itc ) {
+        if ( itc->second->assembles_by_region() )
+            itc->second->set_assembly_region(ASSEMBLE_SHARED);
+        itc->second->execute();
+    }
+
+    std::map<AlgorithmType, SolverAlgorithm *>::iterator it;
+    for ( it = solverAlgMap_.begin(); it != solverAlgMap_.end(); ++it ) {
+        if ( it->second->assembles_by_region() )
+            it->second->set_assembly_region(ASSEMBLE_SHARED);
+        it->second->execute();
+    }
+
+    for ( it = solverConstraintAlgMap_.begin(); it != solverConstraintAlgMap_.end(); ++it ) {
+        it->second->execute();
+    }
+
+    for ( it = solverDirichAlgMap_.begin(); it != solverDirichAlgMap_.end(); ++it ) {
+        it->second->execute();
+    }
+
+    // the shared rows are complete; interior elements touch owned rows only
+    linsys.beginLoadComplete();
+
+    for ( itc = solverAlgorithmMap_.begin(); itc != solverAlgorithmMap_.end(); ++itc ) {
+        if ( itc->second->assembles_by_region() ) {
+            itc->second->set_assembly_region(ASSEMBLE_INTERIOR);
+            itc->second->execute();
+            itc->second->set_assembly_region(ASSEMBLE_ALL);
+        }
+    }
+
+    for ( it = solverAlgMap_.begin(); it != solverAlgMap_.end(); ++it ) {
+        if ( it->second->assembles_by_region() ) {
+            it->second->set_assembly_region(ASSEMBLE_INTERIOR);
+            it->second->execute();
+            it->second->set_assembly_region(ASSEMBLE_ALL);
+        }
+    }
+
+    post_work();
+}
+
 void SolverAlgorithmDriver::post_work() {
     // might provide residual
 }
@@ -149,10 +149,10 @@ void TimeIntegrator::integrate_realm() {
   //    currentTime_ = (*ii)->populate_variables_from_input(currentTime_);
   //  }
 
-  //  // possible restart; need to extract current time (max wins)
-  //  for ( ii = realmVec_.begin(); ii!=realmVec_.end(); ++ii) {
-  //    currentTime_ = std::max(currentTime_, (*ii)->populate_restart(timeStepNm1_, timeStepCount_));
-  //  }
+    // possible restart; need to extract current time (max wins)
+    for ( ii = realmVec_.begin(); ii!=realmVec_.end(); ++ii) {
+        currentTime_ = std::max(currentTime_, (*ii)->populate_restart(timeStepNm1_, timeStepCount_));
+    }
 
   //  // populate data from transfer; init, io and external
   //  for ( ii = realmVec_.begin(); ii!=realmVec_.end(); ++ii) {
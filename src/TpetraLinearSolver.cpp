@@ -6,6 +6,7 @@
 
 #include <HOFlowEnv.h>
 #include <TpetraLinearSolverConfig.h>
+#include <MatrixFreeOperator.h>
 
 #include <stk_util/util/ReportHandler.hpp>
 
@@ -20,6 +21,8 @@
 #include <BelosTpetraAdapter.hpp>
 
 #include <Ifpack2_Factory.hpp>
+#include <MueLu_CreateTpetraPreconditioner.hpp>
+#include <MueLu_TpetraOperator.hpp>
 #include <Kokkos_DefaultNode.hpp>
 #include <Kokkos_Serial.hpp>
 #include <Teuchos_ArrayRCP.hpp>
@@ -33,6 +36,7 @@
 #include <Tpetra_Vector.hpp>
 
 #include <Teuchos_ParameterXMLFileReader.hpp>
+#include <Teuchos_XMLParameterListHelpers.hpp>
 
 #include <iostream>
 
@@ -44,7 +48,15 @@ TpetraLinearSolver::TpetraLinearSolver(std::string solverName,
     LinearSolver(solverName,linearSolvers, config),
     params_(params),
     paramsPrecond_(paramsPrecond),
-    preconditionerType_(config->preconditioner_type())
+    preconditionerType_(config->preconditioner_type()),
+    activeMueLu_(config->useMueLu()),
+    precondInitialized_(false),
+    precondHasBeenComputed_(false),
+    solvesSinceCompute_(0),
+    lastIterations_(0),
+    matrixUnchanged_(false),
+    initialGuess_(config->initial_guess(), config->initialGuessHistory()),
+    guessSlot_(0)
 {
     // nothing to do
 }
@@ -58,6 +70,7 @@ void TpetraLinearSolver::setSystemObjects(Teuchos::RCP<LinSys::Matrix> matrix, T
     ThrowRequire(!rhs.is_null());
 
     matrix_ = matrix;
+    operator_ = matrix;
     rhs_ = rhs;
 }
 
@@ -66,42 +79,157 @@ void TpetraLinearSolver::setupLinearSolver(Teuchos::RCP<LinSys::Vector> sln,
                                             Teuchos::RCP<LinSys::Vector> rhs,
                                             Teuchos::RCP<LinSys::MultiVector> coords) {
     setSystemObjects(matrix,rhs);
+    reset_precond_state();
     problem_ = Teuchos::RCP<LinSys::LinearProblem>(new LinSys::LinearProblem(matrix_, sln, rhs_)); // Create a new Belos problem
 
+    if ( activeMueLu_ ) {
+        // the hierarchy needs a filled matrix; it is built in the first solve
+        coords_ = coords;
+    }
+    else {
+        Ifpack2::Factory factory;
+        preconditioner_ = factory.create(preconditionerType_, Teuchos::rcp_const_cast<const LinSys::Matrix>(matrix_), 0);
+        preconditioner_->setParameters(*paramsPrecond_);
+
+        // delay initialization for some preconditioners
+        if ( "RILUK" != preconditionerType_ ) {
+            preconditioner_->initialize();
+            precondInitialized_ = true;
+        }
+        problem_->setRightPrec(preconditioner_);
+    }
+
+    // create the solver, e.g., gmres, cg, tfqmr, bicgstab
+    LinSys::SolverFactory sFactory;
+    solver_ = sFactory.create(config_->belos_method(), params_);
+    solver_->setProblem(problem_);
+}
+
+void TpetraLinearSolver::setupLinearSolver(Teuchos::RCP<LinSys::Vector> sln,
+                                            Teuchos::RCP<LinSys::Operator> op,
+                                            Teuchos::RCP<LinSys::Vector> diagonal,
+                                            Teuchos::RCP<LinSys::Vector> rhs,
+                                            Teuchos::RCP<LinSys::MultiVector> coords) {
+    ThrowRequire(!op.is_null());
+    ThrowRequire(!rhs.is_null());
+
+    matrix_ = Teuchos::null;
+    operator_ = op;
+    rhs_ = rhs;
+    reset_precond_state();
+    problem_ = Teuchos::RCP<LinSys::LinearProblem>(new LinSys::LinearProblem(operator_, sln, rhs_));
+
+    // "default" maps to jacobi
+    const std::string precondType = (config_->preconditioner_type() == "CHEBYSHEV") ? "chebyshev" : "jacobi";
+    matrixFreePreconditioner_ = Teuchos::rcp(new MatrixFreePreconditioner(operator_, diagonal, precondType, config_->chebyshevDegree()));
+    problem_->setRightPrec(matrixFreePreconditioner_);
+
+    LinSys::SolverFactory sFactory;
+    solver_ = sFactory.create(config_->belos_method(), params_);
+    solver_->setProblem(problem_);
+}
+
+void TpetraLinearSolver::setupLinearSolver(Teuchos::RCP<LinSys::Vector> sln,
+                                            Teuchos::RCP<LinSys::BlockMatrix> matrix,
+                                            Teuchos::RCP<LinSys::Vector> rhs,
+                                            Teuchos::RCP<LinSys::MultiVector> coords) {
+    ThrowRequire(!matrix.is_null());
+    ThrowRequire(!rhs.is_null());
+
+    matrix_ = Teuchos::null;
+    operator_ = matrix;
+    rhs_ = rhs;
+    reset_precond_state();
+    problem_ = Teuchos::RCP<LinSys::LinearProblem>(new LinSys::LinearProblem(operator_, sln, rhs_));
+
+    // block variant of the incomplete factorization
+    const std::string precondType = ("RILUK" == preconditionerType_) ? "RBILUK" : preconditionerType_;
+
+    Teuchos::RCP<const LinSys::RowMatrix> rowMatrix = matrix;
     Ifpack2::Factory factory;
-    preconditioner_ = factory.create(preconditionerType_, Teuchos::rcp_const_cast<const LinSys::Matrix>(matrix_), 0);
+    preconditioner_ = factory.create(precondType, rowMatrix, 0);
     preconditioner_->setParameters(*paramsPrecond_);
 
     // delay initialization for some preconditioners
-    if ( "RILUK" != preconditionerType_ ) {
+    if ( "RBILUK" != precondType ) {
         preconditioner_->initialize();
+        precondInitialized_ = true;
     }
     problem_->setRightPrec(preconditioner_);
 
-    // create the solver, e.g., gmres, cg, tfqmr, bicgstab
     LinSys::SolverFactory sFactory;
-    solver_ = sFactory.create(config_->get_method(), params_);
+    solver_ = sFactory.create(config_->belos_method(), params_);
     solver_->setProblem(problem_);
 }
 
 void TpetraLinearSolver::destroyLinearSolver() {
     problem_ = Teuchos::null;
     preconditioner_ = Teuchos::null;
+    mueluPreconditioner_ = Teuchos::null;
+    matrixFreePreconditioner_ = Teuchos::null;
+    operator_ = Teuchos::null;
     solver_ = Teuchos::null;
     coords_ = Teuchos::null;
+    reset_precond_state();
+}
+
+void TpetraLinearSolver::reset_precond_state() {
+    precondInitialized_ = false;
+    precondHasBeenComputed_ = false;
+    solvesSinceCompute_ = 0;
+    lastIterations_ = 0;
+    matrixUnchanged_ = false;
+    initialGuess_.clear();
+}
+
+bool TpetraLinearSolver::need_precond_compute() const {
+    if ( !precondHasBeenComputed_ )
+        return true;
+
+    // a recompute would reproduce the same preconditioner
+    if ( matrixUnchanged_ )
+        return false;
+
+    // the last solve struggled; the preconditioner is too stale
+    const int maxIterations = config_->recomputePreconditionerIterations();
+    if ( maxIterations > 0 && lastIterations_ > maxIterations )
+        return true;
+
+    if ( reusePreconditioner_ || !recomputePreconditioner_ )
+        return false;
+
+    return solvesSinceCompute_ >= config_->recomputePreconditionerFrequency();
+}
+
+void TpetraLinearSolver::setup_muelu() {
+    if ( mueluPreconditioner_.is_null() ) {
+        Teuchos::ParameterList mueluParams;
+        Teuchos::updateParametersFromXmlFile(config_->muelu_xml_file(), Teuchos::Ptr<Teuchos::ParameterList>(&mueluParams));
+
+        // geometric information for the aggregation and repartitioning
+        if ( !coords_.is_null() )
+            mueluParams.sublist("user data").set("Coordinates", coords_);
+
+        Teuchos::RCP<LinSys::Operator> A = matrix_;
+        mueluPreconditioner_ = MueLu::CreateTpetraPreconditioner<Scalar, LocalOrdinal, GlobalOrdinal, Node>(A, mueluParams);
+        problem_->setRightPrec(mueluPreconditioner_);
+    }
+    else {
+        MueLu::ReuseTpetraPreconditioner(matrix_, *mueluPreconditioner_);
+    }
 }
 
 int TpetraLinearSolver::residual_norm(int whichNorm, Teuchos::RCP<LinSys::Vector> sln, double& norm) {
     LinSys::Vector resid(rhs_->getMap());
     ThrowRequire(! (sln.is_null()  || rhs_.is_null() ) );
 
-    if (matrix_->isFillActive() )
+    if (!matrix_.is_null() && matrix_->isFillActive() )
     {
         // FIXME
         //!matrix_->fillComplete(map_, map_);
         throw std::runtime_error("residual_norm");
     }
-    matrix_->apply(*sln, resid);
+    operator_->apply(*sln, resid);
 
     resid.update(-1.0, *rhs_, 1.0); 
 
@@ -124,11 +252,28 @@ int TpetraLinearSolver::solve(Teuchos::RCP<LinSys::Vector> sln, int & iters, dou
     int whichNorm = 2;
     finalResidNrm=0.0;
 
+    // the graph is static between setups, so the symbolic setup is only done
+    // once; a stale numeric setup is still a valid (if weaker) preconditioner
+    precondComputed_ = need_precond_compute();
+
     double time = -HOFlowEnv::self().hoflow_time();
-    if ( "RILUK" == preconditionerType_ ) {
-      preconditioner_->initialize();
+    if ( precondComputed_ ) {
+      if ( !matrixFreePreconditioner_.is_null() ) {
+        matrixFreePreconditioner_->compute();
+      }
+      else if ( activeMueLu_ ) {
+        setup_muelu();
+      }
+      else {
+        if ( !precondInitialized_ ) {
+          preconditioner_->initialize();
+          precondInitialized_ = true;
+        }
+        preconditioner_->compute();
+      }
+      precondHasBeenComputed_ = true;
+      solvesSinceCompute_ = 0;
     }
-    preconditioner_->compute();
     time += HOFlowEnv::self().hoflow_time();
 
     // Update preconditioner timer for this timestep; actual summing over
@@ -144,10 +289,18 @@ int TpetraLinearSolver::solve(Teuchos::RCP<LinSys::Vector> sln, int & iters, dou
 
     solver_->setParameters(params);
 
+    // sln is zero unless a guess from the earlier solves is requested
+    if ( initialGuess_.active() )
+        initialGuess_.compute(*operator_, *rhs_, *sln, guessSlot_);
+
     problem_->setProblem();
     solver_->solve(); // Actually call the solver and let it do its inner iterations
 
+    initialGuess_.store(*sln, guessSlot_);
+
     iters = solver_->getNumIters();
+    lastIterations_ = iters;
+    solvesSinceCompute_ += 1;
     residual_norm(whichNorm, sln, finalResidNrm);
 
     return status;
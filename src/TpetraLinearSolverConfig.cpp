@@ -50,12 +50,33 @@ void TpetraLinearSolverConfig::load(const YAML::Node& node) {
     params_->set("Output Frequency", output_level);
     Teuchos::RCP<std::ostream> belosOutputStream = Teuchos::rcpFromRef (HOFlowEnv::self().hoflowOutputP0());
     params_->set("Output Stream", belosOutputStream);
-    params_->set("Num Blocks", kspace);
-    params_->set("Maximum Restarts", std::max(1,max_iterations/kspace));
-    std::string orthoType = "ICGS";
-    params_->set("Orthogonalization",orthoType);
     params_->set("Implicit Residual Scaling", "Norm of Preconditioned Initial Residual");
 
+    // cg and pipelined_cg for symmetric positive definite systems; no Krylov basis
+    // to store and no orthogonalization, so kspace does not apply
+    const bool useCG = (method_ == "cg" || method_ == "pipelined_cg");
+    if (method_ == "cg") {
+        belosMethod_ = "PSEUDOBLOCK CG";
+    }
+    else if (method_ == "pipelined_cg") {
+        belosMethod_ = "PIPELINED CG";
+    }
+    else {
+        belosMethod_ = method_;
+        params_->set("Num Blocks", kspace);
+        params_->set("Maximum Restarts", std::max(1,max_iterations/kspace));
+        std::string orthoType = "ICGS";
+        params_->set("Orthogonalization",orthoType);
+    }
+
+    // apply the operator element-by-element instead of assembling a CrsMatrix;
+    // only diagonal preconditioners are available then
+    get_if_present(node, "matrix_free", matrixFree_, matrixFree_);
+    get_if_present(node, "chebyshev_degree", chebyshevDegree_, chebyshevDegree_);
+    if (matrixFree_ && precond_ != "jacobi" && precond_ != "chebyshev" && precond_ != "default") {
+        throw std::runtime_error("matrix_free linear solver supports only the jacobi and chebyshev preconditioners");
+    }
+
     if (precond_ == "sgs") {
         preconditionerType_ = "RELAXATION";
         paramsPrecond_->set("relaxation: type","Symmetric Gauss-Seidel");
@@ -71,18 +92,76 @@ void TpetraLinearSolverConfig::load(const YAML::Node& node) {
         paramsPrecond_->set("relaxation: type","Jacobi");
         paramsPrecond_->set("relaxation: sweeps",1);
     }
+    else if (precond_ == "chebyshev" ) {
+        preconditionerType_ = "CHEBYSHEV";
+        paramsPrecond_->set("chebyshev: degree", chebyshevDegree_);
+    }
     else if (precond_ == "ilut" ) {
         preconditionerType_ = "ILUT";
     }
     else if (precond_ == "riluk" ) {
         preconditionerType_ = "RILUK";
     }
+    else if (precond_ == "muelu" ) {
+        // the multigrid hierarchy is configured entirely by the xml file
+        preconditionerType_ = "MUELU";
+        useMueLu_ = true;
+        get_if_present(node, "muelu_xml_file_name", muelu_xml_file_, muelu_xml_file_);
+    }
     else {
       throw std::runtime_error("invalid linear solver preconditioner specified ");
     }
     
+    // the cg methods need a symmetric preconditioner; the incomplete factorizations are not.
+    // A MueLu hierarchy must use symmetric smoothers (xml file)
+    if (useCG && (precond_ == "ilut" || precond_ == "riluk")) {
+        throw std::runtime_error("linear solver method " + method_ + " needs a symmetric preconditioner: jacobi, sgs, mt_sgs, chebyshev or muelu");
+    }
+
+    // equations with more than one dof per node are assembled into a
+    // BlockCrsMatrix unless the preconditioner needs a point matrix
+    get_if_present(node, "block_crs", blockCrs_, blockCrs_);
+    if (matrixFree_ || useMueLu_ || precond_ == "mt_sgs" || precond_ == "chebyshev" || precond_ == "ilut") {
+        blockCrs_ = false;
+    }
+    
+    // Dirichlet rows and columns are decoupled; the point matrix of a symmetric operator
+    // stays symmetric (e.g. for cg). Not available matrix-free; implies the point CrsMatrix
+    get_if_present(node, "symmetric_dirichlet", symmetricDirichlet_, symmetricDirichlet_);
+    if (symmetricDirichlet_ && matrixFree_) {
+        throw std::runtime_error("symmetric_dirichlet is not available for a matrix_free linear solver");
+    }
+    if (symmetricDirichlet_) {
+        blockCrs_ = false;
+    }
+
+    // initial guess of each solve from the solutions of the earlier time steps;
+    // the tolerance is then relative to |b| as it is for the zero guess
+    get_if_present(node, "initial_guess", initialGuess_, initialGuess_);
+    const int defaultHistory = (initialGuess_ == "projection") ? 6 : initialGuessHistory_;
+    get_if_present(node, "initial_guess_history", initialGuessHistory_, defaultHistory);
+    if (initialGuess_ != "zero" && initialGuess_ != "previous" && initialGuess_ != "extrapolation" && initialGuess_ != "projection") {
+        throw std::runtime_error("invalid linear solver initial_guess specified: " + initialGuess_);
+    }
+    if (initialGuessHistory_ < 1) {
+        throw std::runtime_error("initial_guess_history must be at least 1");
+    }
+    if (initialGuess_ != "zero") {
+        params_->set("Implicit Residual Scaling", "Norm of RHS");
+        if (!useCG)
+            params_->set("Explicit Residual Scaling", "Norm of RHS");
+    }
+    
     get_if_present(node, "recompute_preconditioner", recomputePreconditioner_, recomputePreconditioner_);
     get_if_present(node, "reuse_preconditioner",     reusePreconditioner_,     reusePreconditioner_);
+
+    // numeric setup every N solves; additionally whenever the last solve
+    // needed more than the given number of iterations (0 disables the check)
+    get_if_present(node, "recompute_preconditioner_frequency",  recomputePreconditionerFrequency_,  recomputePreconditionerFrequency_);
+    get_if_present(node, "recompute_preconditioner_iterations", recomputePreconditionerIterations_, recomputePreconditionerIterations_);
+    if (recomputePreconditionerFrequency_ < 1) {
+        throw std::runtime_error("recompute_preconditioner_frequency must be at least 1");
+    }
     // Deleted the reading parameters for writeMatrixFiles. 
     // Always use the value defined in LinearSolverConfig.h
 }
@@ -12,6 +12,10 @@
 #include <Simulation.h>
 #include <LinearSolver.h>
 #include <TpetraLinearSolver.h>
+#include <LinearSolverConfig.h>
+#include <MatrixFreeOperator.h>
+#include <NodeReordering.h>
+#include <MeshCache.h>
 #include <master_element/MasterElement.h>
 #include <EquationSystem.h>
 #include <HOFlowEnv.h>
@@ -55,7 +59,9 @@
 #include <MatrixMarket_Tpetra.hpp>
 
 #include <set>
+#include <numeric>
 #include <limits>
+#include <algorithm>
 #include <type_traits>
 
 #include <sstream>
@@ -68,7 +74,15 @@
 #define GLOBAL_ENTITY_ID_IDOF(gid, ndof) ((gid-1) % ndof)
 
 TpetraLinearSystem::TpetraLinearSystem(Realm &realm, const unsigned numDof, EquationSystem *eqSys, LinearSolver * linearSolver) : 
-    LinearSystem(realm, numDof, eqSys, linearSolver) 
+    LinearSystem(realm, numDof, eqSys, linearSolver),
+    matrixFree_(linearSolver->getConfig()->matrixFree()),
+    blockCrs_(numDof > 1 && linearSolver->getConfig()->blockCrs()),
+    guessTimeStep_(-1),
+    solvesInTimeStep_(0),
+    lhsAssembled_(false),
+    rhsOnly_(false),
+    symmetricDirichlet_(linearSolver->getConfig()->symmetricDirichlet()),
+    replayingGraphBuild_(false)
 {
     Teuchos::ParameterList junk;
     node_ = Teuchos::rcp(new LinSys::Node(junk));
@@ -179,8 +193,8 @@ void TpetraLinearSystem::beginLinearSystemConstruction() {
     LocalOrdinal numNodes = 0;
     LocalOrdinal numSharedNotOwnedNotLocallyOwned = 0; // these are nodes on other procs
     // First, get the number of owned and sharedNotOwned (or num_sharedNotOwned_nodes = num_nodes - num_owned_nodes)
-    //KOKKOS: BucketLoop parallel "reduce" is accumulating 4 sums
-    kokkos_parallel_for("Nalu::TpetraLinearSystem::beginLinearSystemConstructionA", buckets.size(), [&] (const int& ib) {
+    // serial on purpose; the loop accumulates four counters
+    for ( size_t ib = 0; ib < buckets.size(); ++ib ) {
         stk::mesh::Bucket & b = *buckets[ib];
         const stk::mesh::Bucket::size_type length = b.size();
         //KOKKOS: intra BucketLoop parallel reduce
@@ -206,7 +220,7 @@ void TpetraLinearSystem::beginLinearSystemConstruction() {
                 numGhostNodes++;
             }
         }
-    });
+    }
 
     maxOwnedRowId_ = numOwnedNodes * numDof_;
     maxSharedNotOwnedRowId_ = numNodes * numDof_;
@@ -241,6 +255,19 @@ void TpetraLinearSystem::beginLinearSystemConstruction() {
     std::vector<stk::mesh::Entity>::iterator iter = std::unique(owned_nodes.begin(), owned_nodes.end(), CompareEntityEqualById(bulkData, realm_.hoflowGlobalId_));
     owned_nodes.erase(iter, owned_nodes.end());
 
+    // the owned node order defines the local row and leading column ids
+    const std::string & nodeReordering = realm_.solutionOptions_->nodeReordering_;
+    if (nodeReordering != "none") {
+        NodeReordering reordering(realm_, nodeReordering);
+        reordering.apply(owned_nodes);
+
+        size_t l_bandwidth[2] = {reordering.bandwidthBefore_, reordering.bandwidthAfter_};
+        size_t g_bandwidth[2] = {0, 0};
+        stk::all_reduce_max(bulkData.parallel(), l_bandwidth, g_bandwidth, 2);
+        HOFlowEnv::self().hoflowOutputP0() << eqSysName_ << " node_reordering " << nodeReordering
+                                           << ": local bandwidth " << g_bandwidth[0] << " -> " << g_bandwidth[1] << std::endl;
+    }
+
     myLIDs_.clear();
     //KOKKOS: Loop noparallel push_back totalGids_ (std::vector)
     for(stk::mesh::Entity entity : owned_nodes) {
@@ -334,6 +361,7 @@ void TpetraLinearSystem::addConnections(const stk::mesh::Entity* entities, const
 }
 
 void TpetraLinearSystem::buildNodeGraph(const stk::mesh::PartVector & parts) {
+    if (defer_graph_build(GB_NODE, parts)) return;
     beginLinearSystemConstruction();
     stk::mesh::MetaData & metaData = realm_.meta_data();
 
@@ -375,22 +403,26 @@ void TpetraLinearSystem::buildConnectedNodeGraph(stk::mesh::EntityRank rank, con
 }
 
 void TpetraLinearSystem::buildEdgeToNodeGraph(const stk::mesh::PartVector & parts) {
+    if (defer_graph_build(GB_EDGE_TO_NODE, parts)) return;
     beginLinearSystemConstruction();
     buildConnectedNodeGraph(stk::topology::EDGE_RANK, parts);
 }
 
 void TpetraLinearSystem::buildFaceToNodeGraph(const stk::mesh::PartVector & parts) {
+    if (defer_graph_build(GB_FACE_TO_NODE, parts)) return;
     beginLinearSystemConstruction();
     stk::mesh::MetaData & metaData = realm_.meta_data();
     buildConnectedNodeGraph(metaData.side_rank(), parts);
 }
 
 void TpetraLinearSystem::buildElemToNodeGraph(const stk::mesh::PartVector & parts) {
+    if (defer_graph_build(GB_ELEM_TO_NODE, parts)) return;
     beginLinearSystemConstruction();
     buildConnectedNodeGraph(stk::topology::ELEM_RANK, parts);
 }
 
 void TpetraLinearSystem::buildReducedElemToNodeGraph(const stk::mesh::PartVector & parts) {
+    if (defer_graph_build(GB_REDUCED_ELEM_TO_NODE, parts)) return;
     beginLinearSystemConstruction();
     stk::mesh::MetaData & metaData = realm_.meta_data();
   //if (realm_.bulk_data().parallel_rank()==0) std::cerr<<"buildReducedElemToNodeGraph"<<std::endl;
@@ -430,6 +462,7 @@ void TpetraLinearSystem::buildReducedElemToNodeGraph(const stk::mesh::PartVector
 }
 
 void TpetraLinearSystem::buildFaceElemToNodeGraph(const stk::mesh::PartVector & parts) {
+    if (defer_graph_build(GB_FACE_ELEM_TO_NODE, parts)) return;
     beginLinearSystemConstruction();
     stk::mesh::BulkData & bulkData = realm_.bulk_data();
     stk::mesh::MetaData & metaData = realm_.meta_data();
@@ -909,6 +942,152 @@ void TpetraLinearSystem::fill_entity_to_col_LID_mapping() {
     }
 }
 
+void TpetraLinearSystem::color_elements() {
+    const stk::mesh::BulkData & bulkData = realm_.bulk_data();
+    const stk::mesh::MetaData & metaData = realm_.meta_data();
+    const stk::mesh::Selector s_locally_owned = metaData.locally_owned_part() & !(realm_.get_inactive_selector());
+    const stk::mesh::BucketVector & elemBuckets = realm_.get_buckets(stk::topology::ELEMENT_RANK, s_locally_owned);
+
+    elemColor_.assign(bulkData.get_size_of_entity_index_space(), -1);
+    numElemColors_ = 0;
+
+    // colorTakenBy[c] == elemCount marks colour c as used by a neighbour of the current element
+    std::vector<size_t> colorTakenBy;
+    size_t elemCount = 0;
+    for(const stk::mesh::Bucket* bptr : elemBuckets) {
+        const stk::mesh::Bucket & b = *bptr;
+        for(size_t k = 0; k < b.size(); ++k) {
+            ++elemCount;
+            const stk::mesh::Entity * elemNodes = b.begin_nodes(k);
+            const unsigned numNodes = b.num_nodes(k);
+            for(unsigned n = 0; n < numNodes; ++n) {
+                const stk::mesh::Entity * nodeElems = bulkData.begin_elements(elemNodes[n]);
+                const unsigned numNodeElems = bulkData.num_elements(elemNodes[n]);
+                for(unsigned e = 0; e < numNodeElems; ++e) {
+                    const int color = elemColor_[nodeElems[e].local_offset()];
+                    if (color >= 0) {
+                        colorTakenBy[color] = elemCount;
+                    }
+                }
+            }
+
+            int color = 0;
+            while (color < numElemColors_ && colorTakenBy[color] == elemCount) {
+                ++color;
+            }
+            if (color == numElemColors_) {
+                ++numElemColors_;
+                colorTakenBy.push_back(0);
+            }
+            elemColor_[b[k].local_offset()] = color;
+        }
+    }
+
+    int g_maxColors = 0;
+    stk::all_reduce_max(bulkData.parallel(), &numElemColors_, &g_maxColors, 1);
+    HOFlowEnv::self().hoflowOutputP0() << "Element coloring for " << eqSysName_
+                                       << ": max colors per rank " << g_maxColors << std::endl;
+}
+
+void TpetraLinearSystem::build_scatter_plan() {
+    const stk::mesh::BulkData & bulkData = realm_.bulk_data();
+    const stk::mesh::MetaData & metaData = realm_.meta_data();
+    const stk::mesh::Selector s_locally_owned = metaData.locally_owned_part() & !(realm_.get_inactive_selector());
+    const stk::mesh::BucketVector & elemBuckets = realm_.get_buckets(stk::topology::ELEMENT_RANK, s_locally_owned);
+
+    scatterPlanStart_.assign(bulkData.get_size_of_entity_index_space(), std::numeric_limits<size_t>::max());
+    scatterPlan_.clear();
+
+    // value offsets are stored as LocalOrdinal
+    const size_t maxNnz = std::max(ownedLocalMatrix_.values.extent(0), sharedNotOwnedLocalMatrix_.values.extent(0));
+    if (maxNnz >= static_cast<size_t>(std::numeric_limits<LocalOrdinal>::max())) {
+        scatterPlanStart_.clear();
+        HOFlowEnv::self().hoflowOutputP0() << "Scatter plan for " << eqSysName_ << " skipped; too many local entries" << std::endl;
+        return;
+    }
+
+    size_t numPlanned = 0;
+    size_t numSkipped = 0;
+    std::vector<LocalOrdinal> elemPlan;
+    for(const stk::mesh::Bucket* bptr : elemBuckets) {
+        const stk::mesh::Bucket & b = *bptr;
+        for(size_t k = 0; k < b.size(); ++k) {
+            const stk::mesh::Entity * elemNodes = b.begin_nodes(k);
+            const int numRows = b.num_nodes(k)*numDof_;
+            elemPlan.assign(numRows + numRows*numRows, -1);
+
+            bool complete = true;
+            for(int r = 0; r < numRows && complete; ++r) {
+                const LocalOrdinal rowLid = entityToLID_[elemNodes[r/numDof_].local_offset()] + r%numDof_;
+                elemPlan[r] = rowLid;
+
+                // ghosted rows are not assembled
+                const bool useOwned = rowLid < maxOwnedRowId_;
+                if (!useOwned && rowLid >= maxSharedNotOwnedRowId_) {
+                    continue;
+                }
+
+                const LinSys::Matrix::local_matrix_type & localMatrix = useOwned ? ownedLocalMatrix_ : sharedNotOwnedLocalMatrix_;
+                const LocalOrdinal localRow = useOwned ? rowLid : rowLid - maxOwnedRowId_;
+                const LocalOrdinal * rowBegin = localMatrix.graph.entries.data() + localMatrix.graph.row_map(localRow);
+                const LocalOrdinal * rowEnd = localMatrix.graph.entries.data() + localMatrix.graph.row_map(localRow+1);
+                for(int c = 0; c < numRows; ++c) {
+                    const LocalOrdinal colLid = entityToColLID_[elemNodes[c/numDof_].local_offset()] + c%numDof_;
+                    const LocalOrdinal * found = std::lower_bound(rowBegin, rowEnd, colLid);
+                    if (found == rowEnd || *found != colLid) {
+                        complete = false;
+                        break;
+                    }
+                    elemPlan[numRows + r*numRows + c] = found - localMatrix.graph.entries.data();
+                }
+            }
+
+            if (!complete) {
+                ++numSkipped;
+                continue;
+            }
+            scatterPlanStart_[b[k].local_offset()] = scatterPlan_.size();
+            scatterPlan_.insert(scatterPlan_.end(), elemPlan.begin(), elemPlan.end());
+            ++numPlanned;
+        }
+    }
+
+    size_t l_stats[3] = { numPlanned, numSkipped,
+                          scatterPlan_.size()*sizeof(LocalOrdinal) + scatterPlanStart_.size()*sizeof(size_t) };
+    size_t g_stats[3] = { 0, 0, 0 };
+    stk::all_reduce_sum(bulkData.parallel(), l_stats, g_stats, 3);
+    HOFlowEnv::self().hoflowOutputP0() << "Scatter plan for " << eqSysName_
+                                       << ": " << g_stats[0] << " elements, " << g_stats[1] << " without plan, "
+                                       << g_stats[2]/(1024.0*1024.0) << " MB" << std::endl;
+}
+
+void TpetraLinearSystem::build_diagonal_offsets() {
+    const size_t numOwnedRows = maxOwnedRowId_;
+    const size_t numRows = maxSharedNotOwnedRowId_;
+    diagonalOffsets_.resize(numRows);
+
+    // owned and sharedNotOwned rows have col LID == row LID; the columns are sorted
+    for(size_t rowLid = 0; rowLid < numRows; ++rowLid) {
+        const bool useOwned = rowLid < numOwnedRows;
+        const LinSys::Matrix::local_matrix_type & localMatrix = useOwned ? ownedLocalMatrix_ : sharedNotOwnedLocalMatrix_;
+        const LocalOrdinal localRow = useOwned ? rowLid : rowLid - numOwnedRows;
+        const LocalOrdinal * rowBegin = localMatrix.graph.entries.data() + localMatrix.graph.row_map(localRow);
+        const LocalOrdinal * rowEnd = localMatrix.graph.entries.data() + localMatrix.graph.row_map(localRow+1);
+        const LocalOrdinal * found = std::lower_bound(rowBegin, rowEnd, static_cast<LocalOrdinal>(rowLid));
+        ThrowRequireMsg(found != rowEnd && *found == static_cast<LocalOrdinal>(rowLid),
+                        "TpetraLinearSystem: row " << rowLid << " of " << eqSysName_ << " has no diagonal entry");
+        diagonalOffsets_[rowLid] = found - localMatrix.graph.entries.data();
+    }
+}
+
+const LocalOrdinal * TpetraLinearSystem::scatter_plan(stk::mesh::Entity elem) const {
+    const size_t offset = elem.local_offset();
+    if (offset >= scatterPlanStart_.size() || scatterPlanStart_[offset] == std::numeric_limits<size_t>::max()) {
+        return nullptr;
+    }
+    return scatterPlan_.data() + scatterPlanStart_[offset];
+}
+
 void TpetraLinearSystem::storeOwnersForShared() { 
     const stk::mesh::BulkData & bulkData = realm_.bulk_data();
     const stk::mesh::MetaData & metaData = realm_.meta_data();
@@ -1147,6 +1326,51 @@ void fill_in_extra_dof_rows_per_node(LocalGraphArrays& csg, int numDof)
   }
 }
 
+void mesh_gids_of_point_map(const LinSys::Map& pointMap, int numDof, std::vector<GlobalOrdinal>& meshGids)
+{
+  // the dofs of a node are consecutive in all point maps
+  auto pointGids = pointMap.getMyGlobalIndices();
+  meshGids.resize(pointGids.extent(0)/numDof);
+  for(size_t i=0; i<meshGids.size(); ++i) {
+    meshGids[i] = GLOBAL_ENTITY_ID(pointGids(i*numDof), numDof);
+  }
+}
+
+void count_block_row_lengths(const LocalGraphArrays& pointGraph, int numDof, Kokkos::View<size_t*,HostSpace>& blockRowLengths)
+{
+  // the point row of dof 0 holds all dofs of each connected node
+  const LocalOrdinal* cols = pointGraph.colIndices.data();
+  for(size_t i=0; i<blockRowLengths.size(); ++i) {
+    const size_t pointRow = i*numDof;
+    const LocalOrdinal* row = cols+pointGraph.rowPointers(pointRow);
+    const size_t rowLen = pointGraph.get_row_length(pointRow);
+    size_t len = 0;
+    for(size_t j=0; j<rowLen; ++j) {
+      if (row[j] != INVALID && row[j] % numDof == 0) {
+        ++len;
+      }
+    }
+    blockRowLengths(i) = len;
+  }
+}
+
+void fill_block_graph(const LocalGraphArrays& pointGraph, int numDof, LocalGraphArrays& blockGraph)
+{
+  const LocalOrdinal* cols = pointGraph.colIndices.data();
+  LocalOrdinal* blockCols = blockGraph.colIndices.data();
+  for(size_t i=0, ie=blockGraph.rowPointers.size()-1; i<ie; ++i) {
+    const size_t pointRow = i*numDof;
+    const LocalOrdinal* row = cols+pointGraph.rowPointers(pointRow);
+    const size_t rowLen = pointGraph.get_row_length(pointRow);
+    size_t index = blockGraph.rowPointers(i);
+    for(size_t j=0; j<rowLen; ++j) {
+      if (row[j] != INVALID && row[j] % numDof == 0) {
+        blockCols[index++] = row[j]/numDof;
+      }
+    }
+  }
+}
+
 void verify_no_empty_connections(const std::vector<stk::mesh::Entity>& rowEntities,
         const std::vector<std::vector<stk::mesh::Entity> >& connections)
 {
@@ -1158,11 +1382,24 @@ void verify_no_empty_connections(const std::vector<stk::mesh::Entity>& rowEntiti
 void
 TpetraLinearSystem::finalizeLinearSystem()
 {
+  record_mesh_state();
+
+  // deferred graph builds; load the graph from the mesh cache or build it now.
+  // Connections of other builds (e.g. nonconformal) are not part of an entry
+  bool storeGraph = false;
+  if (!deferredGraphBuilds_.empty()) {
+    storeGraph = !inConstruction_;
+    if (storeGraph && load_graph_cache()) {
+      deferredGraphBuilds_.clear();
+      return;
+    }
+    replay_graph_build();
+  }
+
   ThrowRequire(inConstruction_);
   inConstruction_ = false;
 
   stk::mesh::BulkData & bulkData = realm_.bulk_data();
-  stk::mesh::MetaData & metaData = realm_.meta_data();
 
   sort_connections(connections_);
 
@@ -1200,6 +1437,15 @@ TpetraLinearSystem::finalizeLinearSystem()
 
   fill_entity_to_col_LID_mapping();
 
+  // owned rows to the column map; used by the graph and the matrix-free operator
+  bool allowedToReorderLocally = false;
+  colImporter_ = Teuchos::rcp(new LinSys::Import(ownedRowsMap_, optColGids.data()+ownedRowLengths.size(), sourcePIDs.data(), sourcePIDs.size(), allowedToReorderLocally));
+
+  if (matrixFree_) {
+    finalize_matrix_free();
+    return;
+  }
+
   insert_graph_connections(ownedAndSharedNodes_, connections_, ownedGraph, sharedNotOwnedGraph);
 
   insert_communicated_col_indices(neighborProcs, commNeighbors, numDof_, ownedGraph, *ownedRowsMap_, *totalColsMap_);
@@ -1209,6 +1455,26 @@ TpetraLinearSystem::finalizeLinearSystem()
 
   remove_invalid_indices(ownedGraph, ownedRowLengths);
 
+  if (blockCrs_) {
+    finalize_block_crs(ownedGraph, sharedNotOwnedGraph);
+    return;
+  }
+
+  if (storeGraph)
+    store_graph_cache(optColGids, sourcePIDs, ownedRowLengths, globalRowLengths, ownedGraph, sharedNotOwnedGraph);
+  deferredGraphBuilds_.clear();
+
+  finalize_crs(locallyOwnedRowLengths, sharedNotOwnedRowLengths, ownedGraph, sharedNotOwnedGraph);
+}
+
+void
+TpetraLinearSystem::finalize_crs(LinSys::RowLengths & locallyOwnedRowLengths,
+                                 LinSys::RowLengths & sharedNotOwnedRowLengths,
+                                 const LocalGraphArrays & ownedGraph,
+                                 const LocalGraphArrays & sharedNotOwnedGraph)
+{
+  stk::mesh::MetaData & metaData = realm_.meta_data();
+
   sharedNotOwnedGraph_ = Teuchos::rcp(new LinSys::Graph(sharedNotOwnedRowsMap_, totalColsMap_, sharedNotOwnedRowLengths, Tpetra::StaticProfile));
  
   ownedGraph_ = Teuchos::rcp(new LinSys::Graph(ownedRowsMap_, totalColsMap_, locallyOwnedRowLengths, Tpetra::StaticProfile));
@@ -1220,10 +1486,7 @@ TpetraLinearSystem::finalizeLinearSystem()
   params->set<bool>("No Nonlocal Changes", true);
   params->set<bool>("compute local triangular constants", false);
 
-  bool allowedToReorderLocally = false;
-  Teuchos::RCP<LinSys::Import> importer = Teuchos::rcp(new LinSys::Import(ownedRowsMap_, optColGids.data()+ownedRowLengths.size(), sourcePIDs.data(), sourcePIDs.size(), allowedToReorderLocally));
-
-  ownedGraph_->expertStaticFillComplete(ownedRowsMap_, ownedRowsMap_, importer, Teuchos::null, params);
+  ownedGraph_->expertStaticFillComplete(ownedRowsMap_, ownedRowsMap_, colImporter_, Teuchos::null, params);
   sharedNotOwnedGraph_->expertStaticFillComplete(ownedRowsMap_, ownedRowsMap_, Teuchos::null, Teuchos::null, params);
 
   ownedMatrix_ = Teuchos::rcp(new LinSys::Matrix(ownedGraph_));
@@ -1248,44 +1511,409 @@ TpetraLinearSystem::finalizeLinearSystem()
   TpetraLinearSolver *linearSolver = reinterpret_cast<TpetraLinearSolver *>(linearSolver_);
 
   VectorFieldType *coordinates = metaData.get_field<VectorFieldType>(stk::topology::NODE_RANK, realm_.get_coordinates_name());
-//  if (linearSolver->activeMueLu())
-//    copy_stk_to_tpetra(coordinates, coords);
+  if (linearSolver->activeMueLu())
+    copy_stk_to_tpetra(coordinates, coords);
+
+  if (realm_.solutionOptions_->useElementColoring_) {
+    color_elements();
+  }
+
+  dirichletRows_.clear();
+  sharedRowExport_ = SharedRowExport();
+  build_diagonal_offsets();
+
+  if (realm_.solutionOptions_->useScatterPlan_) {
+    build_scatter_plan();
+  }
 
   linearSolver->setupLinearSolver(sln_, ownedMatrix_, ownedRhs_, coords);
 }
 
+bool
+TpetraLinearSystem::use_graph_cache() const
+{
+  return NULL != realm_.meshCache_ && !matrixFree_ && !blockCrs_;
+}
+
+bool
+TpetraLinearSystem::defer_graph_build(const GraphBuildType type, const stk::mesh::PartVector & parts)
+{
+  if (!use_graph_cache() || replayingGraphBuild_)
+    return false;
+  deferredGraphBuilds_.push_back(std::make_pair(type, parts));
+  return true;
+}
+
+void
+TpetraLinearSystem::replay_graph_build()
+{
+  replayingGraphBuild_ = true;
+  for (const std::pair<GraphBuildType, stk::mesh::PartVector> & build : deferredGraphBuilds_) {
+    switch (build.first) {
+    case GB_NODE:                 buildNodeGraph(build.second); break;
+    case GB_FACE_TO_NODE:         buildFaceToNodeGraph(build.second); break;
+    case GB_EDGE_TO_NODE:         buildEdgeToNodeGraph(build.second); break;
+    case GB_ELEM_TO_NODE:         buildElemToNodeGraph(build.second); break;
+    case GB_REDUCED_ELEM_TO_NODE: buildReducedElemToNodeGraph(build.second); break;
+    case GB_FACE_ELEM_TO_NODE:    buildFaceElemToNodeGraph(build.second); break;
+    }
+  }
+  replayingGraphBuild_ = false;
+}
+
+std::string
+TpetraLinearSystem::graph_cache_signature() const
+{
+  std::ostringstream signature;
+  signature << eqSysName_ << " numDof=" << numDof_
+            << " node_reordering=" << realm_.solutionOptions_->nodeReordering_;
+  for (const std::pair<GraphBuildType, stk::mesh::PartVector> & build : deferredGraphBuilds_) {
+    signature << " " << build.first << ":";
+    for (const stk::mesh::Part * part : build.second)
+      signature << part->name() << ",";
+  }
+  return signature.str();
+}
+
+void
+TpetraLinearSystem::node_set_hash(uint64_t & ownedHash, uint64_t & sharedHash)
+{
+  stk::mesh::BulkData & bulkData = realm_.bulk_data();
+  const stk::mesh::Selector s_universal = realm_.meta_data().universal_part()
+    & !(realm_.get_inactive_selector());
+  stk::mesh::BucketVector const& buckets = realm_.get_buckets(stk::topology::NODE_RANK, s_universal);
+
+  // sums of per node hashes; independent of the bucket order
+  ownedHash = 0;
+  sharedHash = 0;
+  for (const stk::mesh::Bucket* bptr : buckets) {
+    for (stk::mesh::Entity node : *bptr) {
+      const int status = getDofStatus(node);
+      if (status & DS_SkippedDOF)
+        continue;
+      const stk::mesh::EntityId nodeId = *stk::mesh::field_data(*realm_.hoflowGlobalId_, node);
+      const uint64_t idHash = MeshCache::hash_bytes(&nodeId, sizeof(nodeId), 0);
+      if (status & DS_OwnedDOF)
+        ownedHash += idHash;
+      if (status & DS_SharedNotOwnedDOF) {
+        const int owner = bulkData.parallel_owner_rank(get_entity_master(bulkData, node, nodeId));
+        sharedHash += MeshCache::hash_bytes(&owner, sizeof(owner), idHash);
+      }
+    }
+  }
+}
+
+bool
+TpetraLinearSystem::load_graph_cache()
+{
+  stk::mesh::BulkData & bulkData = realm_.bulk_data();
+  MeshCacheReader reader(realm_.meshCache_->rank_file(eqSysName_));
+
+  std::string signature;
+  uint64_t ownedHash = 0, sharedHash = 0;
+  uint64_t numOwnedNodes = 0;
+  std::vector<stk::mesh::EntityId> nodeIds;
+  std::vector<int> sharedPids, sourcePIDs;
+  std::vector<GlobalOrdinal> optColGids;
+  std::vector<size_t> ownedLengths, sharedLengths;
+  std::vector<LocalOrdinal> ownedCols, sharedCols;
+  bool hit = reader.valid()
+    && reader.read(signature) && signature == graph_cache_signature()
+    && reader.read(ownedHash) && reader.read(sharedHash)
+    && reader.read(numOwnedNodes) && reader.read(nodeIds) && reader.read(sharedPids)
+    && reader.read(optColGids) && reader.read(sourcePIDs)
+    && reader.read(ownedLengths) && reader.read(ownedCols)
+    && reader.read(sharedLengths) && reader.read(sharedCols);
+
+  // the entry must belong to the same owned and shared nodes
+  if (hit) {
+    uint64_t meshOwnedHash = 0, meshSharedHash = 0;
+    node_set_hash(meshOwnedHash, meshSharedHash);
+    hit = meshOwnedHash == ownedHash && meshSharedHash == sharedHash
+      && numOwnedNodes <= nodeIds.size()
+      && ownedLengths.size() == numOwnedNodes*numDof_
+      && sharedLengths.size() == (nodeIds.size()-numOwnedNodes)*numDof_
+      && sharedPids.size() == sharedLengths.size()
+      && std::accumulate(ownedLengths.begin(), ownedLengths.end(), size_t(0)) == ownedCols.size()
+      && std::accumulate(sharedLengths.begin(), sharedLengths.end(), size_t(0)) == sharedCols.size();
+  }
+
+  // the graph build communicates; either all ranks load or all build
+  int localHit = hit ? 1 : 0, globalHit = 0;
+  stk::all_reduce_min(bulkData.parallel(), &localHit, &globalHit, 1);
+  realm_.meshCache_->count_lookup(1 == globalHit);
+  if (1 != globalHit)
+    return false;
+
+  // rows; owned nodes first, in the (possibly reordered) order of the cold run
+  maxOwnedRowId_ = numOwnedNodes * numDof_;
+  maxSharedNotOwnedRowId_ = nodeIds.size() * numDof_;
+
+  std::vector<GlobalOrdinal> ownedGids, sharedNotOwnedGids;
+  ownedGids.reserve(maxOwnedRowId_);
+  sharedNotOwnedGids.reserve(maxSharedNotOwnedRowId_ - maxOwnedRowId_);
+  myLIDs_.clear();
+  for (size_t i = 0; i < nodeIds.size(); ++i) {
+    myLIDs_[nodeIds[i]] = numDof_*i;
+    std::vector<GlobalOrdinal> & gids = (i < numOwnedNodes) ? ownedGids : sharedNotOwnedGids;
+    for (unsigned idof = 0; idof < numDof_; ++idof)
+      gids.push_back(GID_(nodeIds[i], numDof_, idof));
+  }
+  sharedPids_ = sharedPids;
+
+  const Teuchos::RCP<LinSys::Comm> tpetraComm = Teuchos::rcp(new LinSys::Comm(bulkData.parallel()));
+  ownedRowsMap_ = Teuchos::rcp(new LinSys::Map(Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid(), ownedGids, 1, tpetraComm, node_));
+  sharedNotOwnedRowsMap_ = Teuchos::rcp(new LinSys::Map(Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid(), sharedNotOwnedGids, 1, tpetraComm, node_));
+  exporter_ = Teuchos::rcp(new LinSys::Export(sharedNotOwnedRowsMap_, ownedRowsMap_));
+  fill_entity_to_row_LID_mapping();
+
+  // columns
+  totalColsMap_ = Teuchos::rcp(new LinSys::Map(Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid(), optColGids, 1, tpetraComm, node_));
+  fill_entity_to_col_LID_mapping();
+  bool allowedToReorderLocally = false;
+  colImporter_ = Teuchos::rcp(new LinSys::Import(ownedRowsMap_, optColGids.data()+ownedGids.size(), sourcePIDs.data(), sourcePIDs.size(), allowedToReorderLocally));
+
+  // graphs
+  LinSys::RowLengths sharedNotOwnedRowLengths("rowLengths", sharedLengths.size());
+  LinSys::RowLengths locallyOwnedRowLengths("rowLengths", ownedLengths.size());
+  Kokkos::View<size_t*,HostSpace> ownedRowLengths = locallyOwnedRowLengths.view<HostSpace>();
+  Kokkos::View<size_t*,HostSpace> globalRowLengths = sharedNotOwnedRowLengths.view<HostSpace>();
+  std::copy(ownedLengths.begin(), ownedLengths.end(), ownedRowLengths.data());
+  std::copy(sharedLengths.begin(), sharedLengths.end(), globalRowLengths.data());
+
+  LocalGraphArrays ownedGraph(ownedRowLengths);
+  LocalGraphArrays sharedNotOwnedGraph(globalRowLengths);
+  std::copy(ownedCols.begin(), ownedCols.end(), ownedGraph.colIndices.data());
+  std::copy(sharedCols.begin(), sharedCols.end(), sharedNotOwnedGraph.colIndices.data());
+
+  finalize_crs(locallyOwnedRowLengths, sharedNotOwnedRowLengths, ownedGraph, sharedNotOwnedGraph);
+  return true;
+}
+
+void
+TpetraLinearSystem::store_graph_cache(const std::vector<GlobalOrdinal> & optColGids,
+                                      const std::vector<int> & sourcePIDs,
+                                      const Kokkos::View<size_t*,HostSpace> & ownedRowLengths,
+                                      const Kokkos::View<size_t*,HostSpace> & sharedNotOwnedRowLengths,
+                                      const LocalGraphArrays & ownedGraph,
+                                      const LocalGraphArrays & sharedNotOwnedGraph)
+{
+  uint64_t ownedHash = 0, sharedHash = 0;
+  node_set_hash(ownedHash, sharedHash);
+
+  const uint64_t numOwnedNodes = maxOwnedRowId_/numDof_;
+  std::vector<stk::mesh::EntityId> nodeIds(ownedAndSharedNodes_.size());
+  for (size_t i = 0; i < ownedAndSharedNodes_.size(); ++i)
+    nodeIds[i] = *stk::mesh::field_data(*realm_.hoflowGlobalId_, ownedAndSharedNodes_[i]);
+
+  const size_t * ownedLengths = ownedRowLengths.data();
+  const size_t * sharedLengths = sharedNotOwnedRowLengths.data();
+  const LocalOrdinal * ownedCols = ownedGraph.colIndices.data();
+  const LocalOrdinal * sharedCols = sharedNotOwnedGraph.colIndices.data();
+
+  MeshCacheWriter writer(realm_.meshCache_->rank_file(eqSysName_));
+  writer.write(graph_cache_signature());
+  writer.write(ownedHash);
+  writer.write(sharedHash);
+  writer.write(numOwnedNodes);
+  writer.write(nodeIds);
+  writer.write(sharedPids_);
+  writer.write(optColGids);
+  writer.write(sourcePIDs);
+  writer.write(std::vector<size_t>(ownedLengths, ownedLengths+ownedRowLengths.size()));
+  writer.write(std::vector<LocalOrdinal>(ownedCols, ownedCols+ownedGraph.colIndices.size()));
+  writer.write(std::vector<size_t>(sharedLengths, sharedLengths+sharedNotOwnedRowLengths.size()));
+  writer.write(std::vector<LocalOrdinal>(sharedCols, sharedCols+sharedNotOwnedGraph.colIndices.size()));
+  if (!writer.close())
+    HOFlowEnv::self().hoflowOutputP0() << "TpetraLinearSystem: could not write the graph of " << eqSysName_ << " to the mesh cache" << std::endl;
+}
+
+void
+TpetraLinearSystem::finalize_block_crs(const LocalGraphArrays & ownedGraph, const LocalGraphArrays & sharedNotOwnedGraph)
+{
+  stk::mesh::BulkData & bulkData = realm_.bulk_data();
+  stk::mesh::MetaData & metaData = realm_.meta_data();
+
+  const Teuchos::RCP<LinSys::Comm> tpetraComm = Teuchos::rcp(new LinSys::Comm(bulkData.parallel()));
+  const Tpetra::global_size_t invalidSize = Teuchos::OrdinalTraits<Tpetra::global_size_t>::invalid();
+
+  // node maps in the same local order as the point maps
+  std::vector<GlobalOrdinal> meshGids;
+  mesh_gids_of_point_map(*ownedRowsMap_, numDof_, meshGids);
+  ownedMeshMap_ = Teuchos::rcp(new LinSys::Map(invalidSize, meshGids, 1, tpetraComm, node_));
+  mesh_gids_of_point_map(*sharedNotOwnedRowsMap_, numDof_, meshGids);
+  sharedNotOwnedMeshMap_ = Teuchos::rcp(new LinSys::Map(invalidSize, meshGids, 1, tpetraComm, node_));
+  mesh_gids_of_point_map(*totalColsMap_, numDof_, meshGids);
+  totalColsMeshMap_ = Teuchos::rcp(new LinSys::Map(invalidSize, meshGids, 1, tpetraComm, node_));
+
+  // node graphs; the point graphs are released on return
+  LinSys::RowLengths ownedNodeRowLengths("rowLengths", ownedMeshMap_->getNodeNumElements());
+  LinSys::RowLengths sharedNotOwnedNodeRowLengths("rowLengths", sharedNotOwnedMeshMap_->getNodeNumElements());
+  Kokkos::View<size_t*,HostSpace> ownedLengths = ownedNodeRowLengths.view<HostSpace>();
+  Kokkos::View<size_t*,HostSpace> sharedNotOwnedLengths = sharedNotOwnedNodeRowLengths.view<HostSpace>();
+  count_block_row_lengths(ownedGraph, numDof_, ownedLengths);
+  count_block_row_lengths(sharedNotOwnedGraph, numDof_, sharedNotOwnedLengths);
+
+  LocalGraphArrays ownedNodeGraph(ownedLengths);
+  LocalGraphArrays sharedNotOwnedNodeGraph(sharedNotOwnedLengths);
+  fill_block_graph(ownedGraph, numDof_, ownedNodeGraph);
+  fill_block_graph(sharedNotOwnedGraph, numDof_, sharedNotOwnedNodeGraph);
+
+  ownedBlockGraph_ = Teuchos::rcp(new LinSys::Graph(ownedMeshMap_, totalColsMeshMap_, ownedNodeRowLengths, Tpetra::StaticProfile));
+  sharedNotOwnedBlockGraph_ = Teuchos::rcp(new LinSys::Graph(sharedNotOwnedMeshMap_, totalColsMeshMap_, sharedNotOwnedNodeRowLengths, Tpetra::StaticProfile));
+
+  ownedBlockGraph_->setAllIndices(ownedNodeGraph.rowPointers, ownedNodeGraph.colIndices);
+  sharedNotOwnedBlockGraph_->setAllIndices(sharedNotOwnedNodeGraph.rowPointers, sharedNotOwnedNodeGraph.colIndices);
+
+  Teuchos::RCP<Teuchos::ParameterList> params = Teuchos::rcp(new Teuchos::ParameterList);
+  params->set<bool>("No Nonlocal Changes", true);
+  params->set<bool>("compute local triangular constants", false);
+
+  ownedBlockGraph_->expertStaticFillComplete(ownedMeshMap_, ownedMeshMap_, Teuchos::null, Teuchos::null, params);
+  sharedNotOwnedBlockGraph_->expertStaticFillComplete(ownedMeshMap_, ownedMeshMap_, Teuchos::null, Teuchos::null, params);
+
+  // the point maps are the domain and range; vectors stay as for the CrsMatrix
+  ownedBlockMatrix_ = Teuchos::rcp(new LinSys::BlockMatrix(*ownedBlockGraph_, *ownedRowsMap_, *ownedRowsMap_, numDof_));
+  sharedNotOwnedBlockMatrix_ = Teuchos::rcp(new LinSys::BlockMatrix(*sharedNotOwnedBlockGraph_, *ownedRowsMap_, *ownedRowsMap_, numDof_));
+
+  meshExporter_ = Teuchos::rcp(new LinSys::Export(sharedNotOwnedMeshMap_, ownedMeshMap_));
+
+  ownedRhs_ = Teuchos::rcp(new LinSys::Vector(ownedRowsMap_));
+  sharedNotOwnedRhs_ = Teuchos::rcp(new LinSys::Vector(sharedNotOwnedRowsMap_));
+
+  ownedLocalRhs_ = ownedRhs_->getLocalView<HostSpace>();
+  sharedNotOwnedLocalRhs_ = sharedNotOwnedRhs_->getLocalView<HostSpace>();
+
+  sln_ = Teuchos::rcp(new LinSys::Vector(ownedRowsMap_));
+
+  if (realm_.solutionOptions_->useElementColoring_) {
+    color_elements();
+  }
+
+  const int nDim = metaData.spatial_dimension();
+  Teuchos::RCP<LinSys::MultiVector> coords
+    = Teuchos::RCP<LinSys::MultiVector>(new LinSys::MultiVector(sln_->getMap(), nDim));
+
+  TpetraLinearSolver *linearSolver = reinterpret_cast<TpetraLinearSolver *>(linearSolver_);
+  linearSolver->setupLinearSolver(sln_, ownedBlockMatrix_, ownedRhs_, coords);
+}
+
+void
+TpetraLinearSystem::finalize_matrix_free()
+{
+  stk::mesh::MetaData & metaData = realm_.meta_data();
+
+  ownedRhs_ = Teuchos::rcp(new LinSys::Vector(ownedRowsMap_));
+  sharedNotOwnedRhs_ = Teuchos::rcp(new LinSys::Vector(sharedNotOwnedRowsMap_));
+  ownedLocalRhs_ = ownedRhs_->getLocalView<HostSpace>();
+  sharedNotOwnedLocalRhs_ = sharedNotOwnedRhs_->getLocalView<HostSpace>();
+
+  // the diagonal is all that sumInto keeps of the lhs
+  ownedDiag_ = Teuchos::rcp(new LinSys::Vector(ownedRowsMap_));
+  sharedNotOwnedDiag_ = Teuchos::rcp(new LinSys::Vector(sharedNotOwnedRowsMap_));
+  dirichletMask_ = Teuchos::rcp(new LinSys::Vector(ownedRowsMap_));
+  ownedLocalDiag_ = ownedDiag_->getLocalView<HostSpace>();
+  sharedNotOwnedLocalDiag_ = sharedNotOwnedDiag_->getLocalView<HostSpace>();
+  dirichletLocalMask_ = dirichletMask_->getLocalView<HostSpace>();
+
+  sln_ = Teuchos::rcp(new LinSys::Vector(ownedRowsMap_));
+
+  if (realm_.solutionOptions_->useElementColoring_) {
+    color_elements();
+  }
+
+  MatrixFreeOperator * theOperator = eqSys_->create_matrix_free_operator(*this);
+  if (NULL == theOperator) {
+    throw std::runtime_error("matrix_free linear solver requested for " + eqSysName_ + " which has no matrix-free operator");
+  }
+
+  const int nDim = metaData.spatial_dimension();
+  Teuchos::RCP<LinSys::MultiVector> coords
+    = Teuchos::RCP<LinSys::MultiVector>(new LinSys::MultiVector(sln_->getMap(), nDim));
+
+  TpetraLinearSolver *linearSolver = reinterpret_cast<TpetraLinearSolver *>(linearSolver_);
+  linearSolver->setupLinearSolver(sln_, Teuchos::rcp(theOperator), ownedDiag_, ownedRhs_, coords);
+}
+
 void
 TpetraLinearSystem::zeroSystem()
 {
+  if (matrixFree_) {
+    ownedDiag_->putScalar(0);
+    sharedNotOwnedDiag_->putScalar(0);
+    dirichletMask_->putScalar(1);
+    sharedNotOwnedRhs_->putScalar(0);
+    ownedRhs_->putScalar(0);
+    sln_->putScalar(0);
+    return;
+  }
+
+  if (blockCrs_) {
+    // the block values are filled in place; no resumeFill needed
+    if (!rhsOnly_) {
+      sharedNotOwnedBlockMatrix_->setAllToScalar(0);
+      ownedBlockMatrix_->setAllToScalar(0);
+    }
+    sharedNotOwnedRhs_->putScalar(0);
+    ownedRhs_->putScalar(0);
+    sln_->putScalar(0);
+    return;
+  }
+
   ThrowRequire(!ownedMatrix_.is_null());
   ThrowRequire(!sharedNotOwnedMatrix_.is_null());
   ThrowRequire(!sharedNotOwnedRhs_.is_null());
   ThrowRequire(!ownedRhs_.is_null());
 
-  sharedNotOwnedMatrix_->resumeFill();
-  ownedMatrix_->resumeFill();
+  if (rhsOnly_) {
+    sharedNotOwnedRhs_->putScalar(0);
+    ownedRhs_->putScalar(0);
+    sln_->putScalar(0);
+    return;
+  }
+
+  if (realm_.solutionOptions_->staticGraphAssembly_ && sharedNotOwnedMatrix_->isFillComplete()) {
+    // static graphs; the values are zeroed through the local views and the matrices
+    // stay fill complete until loadComplete
+    Kokkos::deep_copy(sharedNotOwnedLocalMatrix_.values, 0.0);
+    Kokkos::deep_copy(ownedLocalMatrix_.values, 0.0);
+  }
+  else {
+    sharedNotOwnedMatrix_->resumeFill();
+    ownedMatrix_->resumeFill();
 
-  sharedNotOwnedMatrix_->setAllToScalar(0);
-  ownedMatrix_->setAllToScalar(0);
+    sharedNotOwnedMatrix_->setAllToScalar(0);
+    ownedMatrix_->setAllToScalar(0);
+  }
   sharedNotOwnedRhs_->putScalar(0);
   ownedRhs_->putScalar(0);
 
   sln_->putScalar(0);
 }
 
+void
+TpetraLinearSystem::reuse_lhs(const bool lhsUnchanged)
+{
+  // the matrix-free diagonal is cheap to assemble; always rebuild it
+  rhsOnly_ = lhsUnchanged && lhsAssembled_ && !matrixFree_;
+}
+
 namespace
 {
+// assembly may run concurrently unless the device space is Serial
+constexpr bool threadedAssembly = !std::is_same<DeviceSpace, Kokkos::Serial>::value;
+
 template<typename RowViewType>
 void sum_into_row_vec_3(
   RowViewType row_view,
   const int num_entities,
   const int* localIds,
   const int* sort_permutation,
-  const double* input_values)
+  const double* input_values,
+  const bool forceAtomic)
 {
   // assumes that the flattened column indices for block matrices are all stored sequentially
   // specialized for numDof == 3
-  constexpr bool forceAtomic = !std::is_same<DeviceSpace, Kokkos::Serial>::value;
   const LocalOrdinal length = row_view.length;
 
   LocalOrdinal offset = 0;
@@ -1320,14 +1948,14 @@ void sum_into_row (RowViewType row_view,
                    const int numDof,
                    const int * localIds,
                    const int * sort_permutation,
-                   const double * input_values)
+                   const double * input_values,
+                   const bool forceAtomic)
 {
     if (numDof == 3) {
-        sum_into_row_vec_3(row_view, num_entities, localIds, sort_permutation, input_values);
+        sum_into_row_vec_3(row_view, num_entities, localIds, sort_permutation, input_values, forceAtomic);
         return;
     }
 
-    constexpr bool forceAtomic = !std::is_same<DeviceSpace, Kokkos::Serial>::value;
     const LocalOrdinal length = row_view.length;
 
     const int numCols = num_entities * numDof;
@@ -1356,6 +1984,206 @@ void sum_into_row (RowViewType row_view,
 
 }
 
+void TpetraLinearSystem::sum_into_block_row(const LinSys::BlockMatrix & matrix,
+                                            const LocalOrdinal meshRowLid,
+                                            const int numEntities,
+                                            const int * meshColIds,
+                                            const int * entityPermutation,
+                                            const double * lhsRows,
+                                            const size_t lhsStride,
+                                            const bool forceAtomic)
+{
+    const LocalOrdinal * colInds = nullptr;
+    double * vals = nullptr;
+    LocalOrdinal length = 0;
+    matrix.getLocalRowView(meshRowLid, colInds, vals, length);
+
+    // blocks are stored row major
+    const int numDof = numDof_;
+    const int blockSize = numDof*numDof;
+
+    LocalOrdinal offset = 0;
+    for (int j = 0; j < numEntities; ++j) {
+        // since the columns are sorted, we pass through the column idxs once,
+        // updating the offset as we go
+        while (offset < length && colInds[offset] != meshColIds[j]) {
+            ++offset;
+        }
+        if (offset >= length) {
+            return;
+        }
+
+        double * block = vals + offset*blockSize;
+        const double * lhsCols = lhsRows + entityPermutation[j]*numDof;
+        for (int da = 0; da < numDof; ++da) {
+            const double * lhsRow = lhsCols + da*lhsStride;
+            for (int db = 0; db < numDof; ++db) {
+                ThrowAssertMsg(std::isfinite(lhsRow[db]), "Inf or NAN lhs");
+                if (forceAtomic) {
+                    Kokkos::atomic_add(&block[da*numDof+db], lhsRow[db]);
+                }
+                else {
+                    block[da*numDof+db] += lhsRow[db];
+                }
+            }
+        }
+    }
+}
+
+void TpetraLinearSystem::sum_into_block(const unsigned numEntities,
+                                        const stk::mesh::Entity * entities,
+                                        const double * rhs,
+                                        const double * lhs,
+                                        int * meshColIds,
+                                        int * entityPermutation,
+                                        const bool forceAtomic)
+{
+    const int n_obj = numEntities;
+    const size_t numRows = n_obj * numDof_;
+
+    // one sort of the nodes serves all numDof rows of a node
+    for (int i = 0; i < n_obj; ++i) {
+        meshColIds[i] = entityToColLID_[entities[i].local_offset()] / numDof_;
+        entityPermutation[i] = i;
+    }
+    Tpetra::Details::shellSortKeysAndValues(meshColIds, entityPermutation, n_obj);
+
+    for (int i = 0; i < n_obj; ++i) {
+        const LocalOrdinal rowLid = entityToLID_[entities[i].local_offset()];
+        const bool useOwned = rowLid < maxOwnedRowId_;
+        if (!useOwned && rowLid >= maxSharedNotOwnedRowId_) {
+            continue;
+        }
+        const LocalOrdinal actualLocalId = useOwned ? rowLid : rowLid - maxOwnedRowId_;
+
+        if (!rhsOnly_) {
+            const LinSys::BlockMatrix & matrix = useOwned ? *ownedBlockMatrix_ : *sharedNotOwnedBlockMatrix_;
+            sum_into_block_row(matrix, actualLocalId/numDof_, n_obj, meshColIds, entityPermutation,
+                               lhs + i*numDof_*numRows, numRows, forceAtomic);
+        }
+
+        const host_view_type & localRhs = useOwned ? ownedLocalRhs_ : sharedNotOwnedLocalRhs_;
+        for (size_t d = 0; d < numDof_; ++d) {
+            const double cur_rhs = rhs[i*numDof_ + d];
+            ThrowAssertMsg(std::isfinite(cur_rhs), "Inf or NAN rhs");
+            if (forceAtomic) {
+                Kokkos::atomic_add(&localRhs(actualLocalId+d,0), cur_rhs);
+            }
+            else {
+                localRhs(actualLocalId+d,0) += cur_rhs;
+            }
+        }
+    }
+}
+
+void TpetraLinearSystem::replace_block_row(const LinSys::BlockMatrix & matrix,
+                                           const LocalOrdinal meshRowLid,
+                                           const LocalOrdinal meshDiagColLid,
+                                           const unsigned d,
+                                           const double diagonalValue)
+{
+    const LocalOrdinal * colInds = nullptr;
+    double * vals = nullptr;
+    LocalOrdinal length = 0;
+    matrix.getLocalRowView(meshRowLid, colInds, vals, length);
+
+    const int numDof = numDof_;
+    for (LocalOrdinal k = 0; k < length; ++k) {
+        double * blockRow = vals + k*numDof*numDof + d*numDof;
+        for (int e = 0; e < numDof; ++e) {
+            blockRow[e] = 0.0;
+        }
+        if (colInds[k] == meshDiagColLid) {
+            blockRow[d] = diagonalValue;
+        }
+    }
+}
+
+void TpetraLinearSystem::sum_into_diagonal_and_rhs(const LocalOrdinal rowLid,
+                                                   const double diagValue,
+                                                   const double rhsValue,
+                                                   const bool forceAtomic)
+{
+    double * diag = nullptr;
+    double * rhs = nullptr;
+    if (rowLid < maxOwnedRowId_) {
+        diag = &ownedLocalDiag_(rowLid,0);
+        rhs = &ownedLocalRhs_(rowLid,0);
+    }
+    else if (rowLid < maxSharedNotOwnedRowId_) {
+        const LocalOrdinal actualLocalId = rowLid - maxOwnedRowId_;
+        diag = &sharedNotOwnedLocalDiag_(actualLocalId,0);
+        rhs = &sharedNotOwnedLocalRhs_(actualLocalId,0);
+    }
+    else {
+        return;
+    }
+
+    ThrowAssertMsg(std::isfinite(diagValue), "Inf or NAN lhs");
+    if (forceAtomic) {
+        Kokkos::atomic_add(diag, diagValue);
+        Kokkos::atomic_add(rhs, rhsValue);
+    }
+    else {
+        *diag += diagValue;
+        *rhs += rhsValue;
+    }
+}
+
+void TpetraLinearSystem::sumIntoDiagonal(const unsigned numEntities,
+                                         const stk::mesh::Entity * entities,
+                                         const double * lhs,
+                                         const double * rhs)
+{
+    ThrowRequireMsg(numDof_ == 1, "sumIntoDiagonal requires a single dof equation");
+
+    const bool forceAtomic = threadedAssembly && !atomicFreeAssembly_;
+
+    if (blockCrs_ || (!matrixFree_ && diagonalOffsets_.empty())) {
+        LinearSystem::sumIntoDiagonal(numEntities, entities, lhs, rhs);
+        return;
+    }
+
+    double * const ownedValues = matrixFree_ ? nullptr : ownedLocalMatrix_.values.data();
+    double * const sharedNotOwnedValues = matrixFree_ ? nullptr : sharedNotOwnedLocalMatrix_.values.data();
+
+    for (unsigned i = 0; i < numEntities; ++i) {
+        const LocalOrdinal rowLid = entityToLID_[entities[i].local_offset()];
+        ThrowAssertMsg(std::isfinite(rhs[i]), "Inf or NAN rhs");
+
+        if (matrixFree_) {
+            sum_into_diagonal_and_rhs(rowLid, lhs[i], rhs[i], forceAtomic);
+            continue;
+        }
+
+        double * values = nullptr;
+        double * rhsValue = nullptr;
+        if (rowLid < maxOwnedRowId_) {
+            values = ownedValues;
+            rhsValue = &ownedLocalRhs_(rowLid,0);
+        }
+        else if (rowLid < maxSharedNotOwnedRowId_) {
+            values = sharedNotOwnedValues;
+            rhsValue = &sharedNotOwnedLocalRhs_(rowLid - maxOwnedRowId_,0);
+        }
+        else {
+            continue;
+        }
+
+        ThrowAssertMsg(std::isfinite(lhs[i]), "Inf or NAN lhs");
+        if (forceAtomic) {
+            if (!rhsOnly_)
+                Kokkos::atomic_add(&values[diagonalOffsets_[rowLid]], lhs[i]);
+            Kokkos::atomic_add(rhsValue, rhs[i]);
+        }
+        else {
+            if (!rhsOnly_)
+                values[diagonalOffsets_[rowLid]] += lhs[i];
+            *rhsValue += rhs[i];
+        }
+    }
+}
+
 void TpetraLinearSystem::sumInto(unsigned numEntities,
                                  const stk::mesh::Entity* entities,
                                  const SharedMemView<const double*> & rhs,
@@ -1364,13 +2192,19 @@ void TpetraLinearSystem::sumInto(unsigned numEntities,
                                  const SharedMemView<int*> & sortPermutation,
                                  const char * trace_tag)
 {
-    constexpr bool forceAtomic = !std::is_same<DeviceSpace, Kokkos::Serial>::value;
+    // a single element colour never touches a row twice; no atomics needed then
+    const bool forceAtomic = threadedAssembly && !atomicFreeAssembly_;
 
     ThrowAssertMsg(lhs.is_contiguous(), "LHS assumed contiguous");
     ThrowAssertMsg(rhs.is_contiguous(), "RHS assumed contiguous");
     ThrowAssertMsg(localIds.is_contiguous(), "localIds assumed contiguous");
     ThrowAssertMsg(sortPermutation.is_contiguous(), "sortPermutation assumed contiguous");
 
+    if (blockCrs_) {
+        sum_into_block(numEntities, entities, rhs.data(), lhs.data(), localIds.data(), sortPermutation.data(), forceAtomic);
+        return;
+    }
+
     const int n_obj = numEntities;
     const int numRows = n_obj * numDof_;
 
@@ -1397,8 +2231,12 @@ void TpetraLinearSystem::sumInto(unsigned numEntities,
         const double cur_rhs = rhs[cur_perm_index];
         ThrowAssertMsg(std::isfinite(cur_rhs), "Inf or NAN rhs");
 
-        if(rowLid < maxOwnedRowId_) {
-            sum_into_row(ownedLocalMatrix_.row(rowLid), n_obj, numDof_, localIds.data(), sortPermutation.data(), cur_lhs);
+        if (matrixFree_) {
+            sum_into_diagonal_and_rhs(rowLid, cur_lhs[cur_perm_index], cur_rhs, forceAtomic);
+        }
+        else if(rowLid < maxOwnedRowId_) {
+            if (!rhsOnly_)
+                sum_into_row(ownedLocalMatrix_.row(rowLid), n_obj, numDof_, localIds.data(), sortPermutation.data(), cur_lhs, forceAtomic);
             if (forceAtomic) {
               Kokkos::atomic_add(&ownedLocalRhs_(rowLid,0), cur_rhs);
             }
@@ -1408,8 +2246,9 @@ void TpetraLinearSystem::sumInto(unsigned numEntities,
         }
         else if (rowLid < maxSharedNotOwnedRowId_) {
             LocalOrdinal actualLocalId = rowLid - maxOwnedRowId_;
-            sum_into_row(sharedNotOwnedLocalMatrix_.row(actualLocalId), n_obj, numDof_,
-                localIds.data(), sortPermutation.data(), cur_lhs);
+            if (!rhsOnly_)
+                sum_into_row(sharedNotOwnedLocalMatrix_.row(actualLocalId), n_obj, numDof_,
+                    localIds.data(), sortPermutation.data(), cur_lhs, forceAtomic);
 
             if (forceAtomic) {
                 Kokkos::atomic_add(&sharedNotOwnedLocalRhs_(actualLocalId,0), cur_rhs);
@@ -1421,6 +2260,100 @@ void TpetraLinearSystem::sumInto(unsigned numEntities,
     }
 }
 
+void TpetraLinearSystem::sum_into_planned(const LocalOrdinal * plan,
+                                          const int numRows,
+                                          const double * rhs,
+                                          const double * lhs,
+                                          const bool forceAtomic)
+{
+    double * const ownedValues = ownedLocalMatrix_.values.data();
+    double * const sharedNotOwnedValues = sharedNotOwnedLocalMatrix_.values.data();
+    const LocalOrdinal * const valueOffsets = plan + numRows;
+
+    for (int r = 0; r < numRows; ++r) {
+        const LocalOrdinal rowLid = plan[r];
+        double * values = nullptr;
+        double * rhsValue = nullptr;
+        if (rowLid < maxOwnedRowId_) {
+            values = ownedValues;
+            rhsValue = &ownedLocalRhs_(rowLid,0);
+        }
+        else if (rowLid < maxSharedNotOwnedRowId_) {
+            values = sharedNotOwnedValues;
+            rhsValue = &sharedNotOwnedLocalRhs_(rowLid - maxOwnedRowId_,0);
+        }
+        else {
+            continue;
+        }
+
+        const double cur_rhs = rhs[r];
+        ThrowAssertMsg(std::isfinite(cur_rhs), "Inf or NAN rhs");
+
+        if (!rhsOnly_) {
+            const double * const cur_lhs = lhs + r*numRows;
+            const LocalOrdinal * const offsets = valueOffsets + r*numRows;
+            for (int c = 0; c < numRows; ++c) {
+                ThrowAssertMsg(std::isfinite(cur_lhs[c]), "Inf or NAN lhs");
+                if (forceAtomic) {
+                    Kokkos::atomic_add(&values[offsets[c]], cur_lhs[c]);
+                }
+                else {
+                    values[offsets[c]] += cur_lhs[c];
+                }
+            }
+        }
+
+        if (forceAtomic) {
+            Kokkos::atomic_add(rhsValue, cur_rhs);
+        }
+        else {
+            *rhsValue += cur_rhs;
+        }
+    }
+}
+
+void TpetraLinearSystem::sumInto(stk::mesh::Entity elem,
+                                 unsigned numEntities,
+                                 const stk::mesh::Entity* entities,
+                                 const SharedMemView<const double*> & rhs,
+                                 const SharedMemView<const double**> & lhs,
+                                 const SharedMemView<int*> & localIds,
+                                 const SharedMemView<int*> & sortPermutation,
+                                 const char * trace_tag)
+{
+    const LocalOrdinal * plan = scatter_plan(elem);
+    if (nullptr == plan) {
+        sumInto(numEntities, entities, rhs, lhs, localIds, sortPermutation, trace_tag);
+        return;
+    }
+
+    ThrowAssertMsg(lhs.is_contiguous(), "LHS assumed contiguous");
+    ThrowAssert(plan[0] == entityToLID_[entities[0].local_offset()]);
+
+    const bool forceAtomic = threadedAssembly && !atomicFreeAssembly_;
+    sum_into_planned(plan, numEntities*numDof_, rhs.data(), lhs.data(), forceAtomic);
+}
+
+void TpetraLinearSystem::sumInto(stk::mesh::Entity elem,
+                                 const std::vector<stk::mesh::Entity> & entities,
+                                 std::vector<int> &scratchIds,
+                                 std::vector<double> &scratchVals,
+                                 const std::vector<double> & rhs,
+                                 const std::vector<double> & lhs,
+                                 const char *trace_tag)
+{
+    const LocalOrdinal * plan = scatter_plan(elem);
+    if (nullptr == plan) {
+        sumInto(entities, scratchIds, scratchVals, rhs, lhs, trace_tag);
+        return;
+    }
+
+    ThrowAssert(plan[0] == entityToLID_[entities[0].local_offset()]);
+
+    const bool forceAtomic = threadedAssembly && !atomicFreeAssembly_;
+    sum_into_planned(plan, entities.size()*numDof_, rhs.data(), lhs.data(), forceAtomic);
+}
+
 // Fills the coefficients calculated from the solver algorithm 
 // into the matrix of the system of equations
 void TpetraLinearSystem::sumInto(const std::vector<stk::mesh::Entity> & entities,
@@ -1438,6 +2371,13 @@ void TpetraLinearSystem::sumInto(const std::vector<stk::mesh::Entity> & entities
 
     scratchIds.resize(numRows);
     sortPermutation_.resize(numRows);
+
+    const bool forceAtomic = threadedAssembly && !atomicFreeAssembly_;
+
+    if (blockCrs_) {
+        sum_into_block(n_obj, entities.data(), rhs.data(), lhs.data(), scratchIds.data(), sortPermutation_.data(), forceAtomic);
+        return;
+    }
     
     // Iterate through entities, e.g. nodes
     for (size_t i = 0; i < n_obj; i++) {
@@ -1468,14 +2408,19 @@ void TpetraLinearSystem::sumInto(const std::vector<stk::mesh::Entity> & entities
         const double cur_rhs = rhs[cur_perm_index];
         ThrowAssertMsg(std::isfinite(cur_rhs), "Invalid rhs");
 
-        if(rowLid < maxOwnedRowId_) {
-            sum_into_row(ownedLocalMatrix_.row(rowLid),  n_obj, numDof_, scratchIds.data(), sortPermutation_.data(), cur_lhs);
+        if (matrixFree_) {
+            sum_into_diagonal_and_rhs(rowLid, cur_lhs[cur_perm_index], cur_rhs, forceAtomic);
+        }
+        else if(rowLid < maxOwnedRowId_) {
+            if (!rhsOnly_)
+                sum_into_row(ownedLocalMatrix_.row(rowLid),  n_obj, numDof_, scratchIds.data(), sortPermutation_.data(), cur_lhs, forceAtomic);
             ownedLocalRhs_(rowLid,0) += cur_rhs;
         }
         else if (rowLid < maxSharedNotOwnedRowId_) {
             LocalOrdinal actualLocalId = rowLid - maxOwnedRowId_;
-            sum_into_row(sharedNotOwnedLocalMatrix_.row(actualLocalId),  n_obj, numDof_,
-                scratchIds.data(), sortPermutation_.data(), cur_lhs);
+            if (!rhsOnly_)
+                sum_into_row(sharedNotOwnedLocalMatrix_.row(actualLocalId),  n_obj, numDof_,
+                    scratchIds.data(), sortPermutation_.data(), cur_lhs, forceAtomic);
 
             sharedNotOwnedLocalRhs_(actualLocalId,0) += cur_rhs;
         }
@@ -1492,6 +2437,23 @@ void TpetraLinearSystem::applyDirichletBCs(stk::mesh::FieldBase * solutionField,
 
     double adbc_time = -HOFlowEnv::self().hoflow_time();
 
+    // point matrix; the rows of these parts are cached
+    if (!matrixFree_ && !blockCrs_) {
+        std::vector<unsigned> key;
+        for (const stk::mesh::Part * part : parts)
+            key.push_back(part->mesh_meta_data_ordinal());
+        key.push_back(beginPos);
+        key.push_back(endPos);
+
+        std::map<std::vector<unsigned>, DirichletRows>::iterator it = dirichletRows_.find(key);
+        if (it == dirichletRows_.end()) {
+            it = dirichletRows_.insert(std::make_pair(key, DirichletRows())).first;
+            build_dirichlet_rows(it->second, solutionField, parts, beginPos, endPos);
+        }
+        apply_cached_dirichlet(it->second, solutionField, bcValuesField);
+        return;
+    }
+
     const stk::mesh::Selector selector = (metaData.locally_owned_part() | metaData.globally_shared_part())
                                          & stk::mesh::selectUnion(parts)
                                          & stk::mesh::selectField(*solutionField) 
@@ -1544,14 +2506,33 @@ void TpetraLinearSystem::applyDirichletBCs(stk::mesh::FieldBase * solutionField,
                 // Adjust the LHS
                 const double diagonal_value = useOwned ? 1.0 : 0.0;
 
-                matrix->getLocalRowView(actualLocalId, indices, values);
-                const size_t rowLength = values.size();
-                if (rowLength > 0) {
-                    new_values.resize(rowLength);
-                    for(size_t i=0; i < rowLength; ++i) {
-                        new_values[i] = (indices[i] == localId) ? diagonal_value : 0;
+                if (matrixFree_) {
+                    // identity row; the operator drops the off-diagonal part of masked rows
+                    if (useOwned) {
+                        ownedLocalDiag_(actualLocalId,0) = diagonal_value;
+                        dirichletLocalMask_(actualLocalId,0) = 0.0;
+                    }
+                    else {
+                        sharedNotOwnedLocalDiag_(actualLocalId,0) = diagonal_value;
+                    }
+                }
+                else if (blockCrs_) {
+                    if (!rhsOnly_) {
+                        const LinSys::BlockMatrix & blockMatrix = useOwned ? *ownedBlockMatrix_ : *sharedNotOwnedBlockMatrix_;
+                        replace_block_row(blockMatrix, actualLocalId/numDof_, localIdOffset/numDof_, d, diagonal_value);
+                    }
+                }
+                else if (!rhsOnly_) {
+                    // the reused LHS already holds the identity row
+                    matrix->getLocalRowView(actualLocalId, indices, values);
+                    const size_t rowLength = values.size();
+                    if (rowLength > 0) {
+                        new_values.resize(rowLength);
+                        for(size_t i=0; i < rowLength; ++i) {
+                            new_values[i] = (indices[i] == localId) ? diagonal_value : 0;
+                        }
+                        local_matrix.replaceValues(actualLocalId, &indices[0], rowLength, new_values.data(), internalMatrixIsSorted);
                     }
-                    local_matrix.replaceValues(actualLocalId, &indices[0], rowLength, new_values.data(), internalMatrixIsSorted);
                 }
 
                 // Replace the RHS residual with (desired - actual)
@@ -1565,6 +2546,133 @@ void TpetraLinearSystem::applyDirichletBCs(stk::mesh::FieldBase * solutionField,
     adbc_time += HOFlowEnv::self().hoflow_time();
 }
 
+void TpetraLinearSystem::build_dirichlet_rows(DirichletRows & bcRows,
+                                              stk::mesh::FieldBase * solutionField,
+                                              const stk::mesh::PartVector & parts,
+                                              const unsigned beginPos,
+                                              const unsigned endPos)
+{
+    stk::mesh::MetaData & metaData = realm_.meta_data();
+
+    const stk::mesh::Selector selector = (metaData.locally_owned_part() | metaData.globally_shared_part())
+                                         & stk::mesh::selectUnion(parts)
+                                         & stk::mesh::selectField(*solutionField)
+                                         & !(realm_.get_inactive_selector());
+
+    stk::mesh::BucketVector const & buckets = realm_.get_buckets( stk::topology::NODE_RANK, selector );
+    for(const stk::mesh::Bucket * bptr : buckets) {
+        const stk::mesh::Bucket & b = *bptr;
+        ThrowRequire(field_bytes_per_entity(*solutionField, b) / sizeof(double) == numDof_);
+        for (stk::mesh::Bucket::size_type k = 0 ; k < b.size() ; ++k ) {
+            const LocalOrdinal localIdOffset = entityToLID_[b[k].local_offset()];
+            for (unsigned d=beginPos; d < endPos; ++d) {
+                const LocalOrdinal localId = localIdOffset + d;
+                ThrowRequireMsg(localId < maxSharedNotOwnedRowId_, "logic error: localId > maxSharedNotOwnedRowId_");
+                bcRows.nodes.push_back(b[k]);
+                bcRows.dofs.push_back(d);
+                bcRows.rowLids.push_back(localId);
+            }
+        }
+    }
+
+    const size_t numBcRows = bcRows.rowLids.size();
+    bcRows.couplingStart.assign(numBcRows+1, 0);
+    if (!symmetricDirichlet_)
+        return;
+
+    // Dirichlet index of each owned and shared row; col LID == row LID for these
+    std::vector<int> bcIndex(maxSharedNotOwnedRowId_, -1);
+    for (size_t k = 0; k < numBcRows; ++k)
+        bcIndex[bcRows.rowLids[k]] = k;
+
+    // entries in column k of the other rows, counted first and then filled
+    for (int pass = 0; pass < 2; ++pass) {
+        std::vector<size_t> next(bcRows.couplingStart.begin(), bcRows.couplingStart.end()-1);
+        for (LocalOrdinal rowLid = 0; rowLid < maxSharedNotOwnedRowId_; ++rowLid) {
+            if (bcIndex[rowLid] >= 0)
+                continue;
+
+            const bool useOwned = rowLid < maxOwnedRowId_;
+            const LinSys::Matrix::local_matrix_type & localMatrix = useOwned ? ownedLocalMatrix_ : sharedNotOwnedLocalMatrix_;
+            const LocalOrdinal localRow = useOwned ? rowLid : rowLid - maxOwnedRowId_;
+            for (size_t offset = localMatrix.graph.row_map(localRow); offset < localMatrix.graph.row_map(localRow+1); ++offset) {
+                const LocalOrdinal colLid = localMatrix.graph.entries(offset);
+                if (colLid >= maxSharedNotOwnedRowId_ || bcIndex[colLid] < 0)
+                    continue;
+
+                const int k = bcIndex[colLid];
+                if (pass == 0) {
+                    ++bcRows.couplingStart[k+1];
+                }
+                else {
+                    bcRows.couplingRowLids[next[k]] = rowLid;
+                    bcRows.couplingOffsets[next[k]] = offset;
+                    ++next[k];
+                }
+            }
+        }
+
+        if (pass == 0) {
+            for (size_t k = 0; k < numBcRows; ++k)
+                bcRows.couplingStart[k+1] += bcRows.couplingStart[k];
+            const size_t numCouplings = bcRows.couplingStart[numBcRows];
+            bcRows.couplingRowLids.resize(numCouplings);
+            bcRows.couplingOffsets.resize(numCouplings);
+            bcRows.couplingValues.assign(numCouplings, 0.0);
+        }
+    }
+}
+
+void TpetraLinearSystem::apply_cached_dirichlet(DirichletRows & bcRows,
+                                                stk::mesh::FieldBase * solutionField,
+                                                stk::mesh::FieldBase * bcValuesField)
+{
+    double * const ownedValues = ownedLocalMatrix_.values.data();
+    double * const sharedNotOwnedValues = sharedNotOwnedLocalMatrix_.values.data();
+
+    const size_t numBcRows = bcRows.rowLids.size();
+    for (size_t k = 0; k < numBcRows; ++k) {
+        const LocalOrdinal localId = bcRows.rowLids[k];
+        const bool useOwned = localId < maxOwnedRowId_;
+        const LocalOrdinal actualLocalId = useOwned ? localId : localId - maxOwnedRowId_;
+
+        // desired - actual; known on every process that has the node
+        const unsigned d = bcRows.dofs[k];
+        const double * solution = (double*)stk::mesh::field_data(*solutionField, bcRows.nodes[k]);
+        const double * bcValues = (double*)stk::mesh::field_data(*bcValuesField, bcRows.nodes[k]);
+        const double bcIncrement = bcValues[d] - solution[d];
+
+        // column k moves to the rhs of the other rows; the reused LHS has it zeroed already
+        for (size_t e = bcRows.couplingStart[k]; e < bcRows.couplingStart[k+1]; ++e) {
+            const LocalOrdinal rowLid = bcRows.couplingRowLids[e];
+            const bool rowOwned = rowLid < maxOwnedRowId_;
+            if (!rhsOnly_) {
+                double & value = (rowOwned ? ownedValues : sharedNotOwnedValues)[bcRows.couplingOffsets[e]];
+                bcRows.couplingValues[e] = value;
+                value = 0.0;
+            }
+            if (rowOwned)
+                ownedLocalRhs_(rowLid,0) -= bcRows.couplingValues[e]*bcIncrement;
+            else
+                sharedNotOwnedLocalRhs_(rowLid - maxOwnedRowId_,0) -= bcRows.couplingValues[e]*bcIncrement;
+        }
+
+        // identity row on the owner
+        if (!rhsOnly_) {
+            const LinSys::Matrix::local_matrix_type & localMatrix = useOwned ? ownedLocalMatrix_ : sharedNotOwnedLocalMatrix_;
+            double * values = useOwned ? ownedValues : sharedNotOwnedValues;
+            const double diagonal_value = useOwned ? 1.0 : 0.0;
+            for (size_t offset = localMatrix.graph.row_map(actualLocalId); offset < localMatrix.graph.row_map(actualLocalId+1); ++offset)
+                values[offset] = (localMatrix.graph.entries(offset) == localId) ? diagonal_value : 0.0;
+        }
+
+        if (useOwned)
+            ownedLocalRhs_(actualLocalId,0) = bcIncrement;
+        else
+            sharedNotOwnedLocalRhs_(actualLocalId,0) = 0.0;
+    }
+}
+
 void
 TpetraLinearSystem::prepareConstraints(
   const unsigned beginPos,
@@ -1636,23 +2744,40 @@ TpetraLinearSystem::resetRows(
       const bool useOwned = (localId < maxOwnedRowId_);
       const LocalOrdinal actualLocalId =
         useOwned ? localId : (localId - maxOwnedRowId_);
-      Teuchos::RCP<LinSys::Matrix> matrix =
-        useOwned ? ownedMatrix_ : sharedNotOwnedMatrix_;
-      const LinSys::Matrix::local_matrix_type& local_matrix = matrix->getLocalMatrix();
-
       if (localId > maxSharedNotOwnedRowId_) {
         throw std::runtime_error("logic error: localId > maxSharedNotOwnedRowId");
       }
 
       // Adjust the LHS; zero out all entries (including diagonal)
-      matrix->getLocalRowView(actualLocalId, indices, values);
-      const size_t rowLength = values.size();
-      if (rowLength > 0) {
-        new_values.resize(rowLength);
-        for (size_t i=0; i < rowLength; i++) {
-          new_values[i] = 0.0;
-        }
-        local_matrix.replaceValues(actualLocalId, &indices[0], rowLength, new_values.data(), internalMatrixIsSorted);
+      if (matrixFree_) {
+        if (useOwned) {
+          ownedLocalDiag_(actualLocalId,0) = 0.0;
+          dirichletLocalMask_(actualLocalId,0) = 0.0;
+        }
+        else {
+          sharedNotOwnedLocalDiag_(actualLocalId,0) = 0.0;
+        }
+      }
+      else if (blockCrs_) {
+        if (!rhsOnly_) {
+          const LinSys::BlockMatrix & blockMatrix = useOwned ? *ownedBlockMatrix_ : *sharedNotOwnedBlockMatrix_;
+          replace_block_row(blockMatrix, actualLocalId/numDof_, localIdOffset/numDof_, d, 0.0);
+        }
+      }
+      else if (!rhsOnly_) {
+        Teuchos::RCP<LinSys::Matrix> matrix =
+          useOwned ? ownedMatrix_ : sharedNotOwnedMatrix_;
+        const LinSys::Matrix::local_matrix_type& local_matrix = matrix->getLocalMatrix();
+
+        matrix->getLocalRowView(actualLocalId, indices, values);
+        const size_t rowLength = values.size();
+        if (rowLength > 0) {
+          new_values.resize(rowLength);
+          for (size_t i=0; i < rowLength; i++) {
+            new_values[i] = 0.0;
+          }
+          local_matrix.replaceValues(actualLocalId, &indices[0], rowLength, new_values.data(), internalMatrixIsSorted);
+        }
       }
 
       // Replace RHS residual entry = 0.0
@@ -1666,11 +2791,60 @@ TpetraLinearSystem::resetRows(
 void
 TpetraLinearSystem::loadComplete()
 {
+  if (matrixFree_) {
+    ownedDiag_->doExport(*sharedNotOwnedDiag_, *exporter_, Tpetra::ADD);
+    ownedRhs_->doExport(*sharedNotOwnedRhs_, *exporter_, Tpetra::ADD);
+    return;
+  }
+
+  if (rhsOnly_) {
+    ownedRhs_->doExport(*sharedNotOwnedRhs_, *exporter_, Tpetra::ADD);
+    return;
+  }
+
+  if (blockCrs_) {
+    // the block graphs are fill complete; only the shared blocks move
+    ownedBlockMatrix_->doExport(*sharedNotOwnedBlockMatrix_, *meshExporter_, Tpetra::ADD);
+    ownedRhs_->doExport(*sharedNotOwnedRhs_, *exporter_, Tpetra::ADD);
+    lhsAssembled_ = true;
+    return;
+  }
+
   // LHS
   Teuchos::RCP<Teuchos::ParameterList> params = Teuchos::parameterList ();
   params->set("No Nonlocal Changes", true);
   bool do_params=false;
 
+  if (sharedRowExport_.inFlight) {
+    // the shared rows left in beginLoadComplete; only the fill state remains
+    end_shared_row_export();
+    if (!sharedNotOwnedMatrix_->isFillComplete())
+      sharedNotOwnedMatrix_->fillComplete(params);
+    if (!ownedMatrix_->isFillComplete())
+      ownedMatrix_->fillComplete(params);
+
+    lhsAssembled_ = true;
+    return;
+  }
+
+  if (realm_.solutionOptions_->staticGraphAssembly_) {
+    // all values are assembled through the local views; nothing to communicate
+    // but the shared rows. The sharedNotOwned matrix is completed once, the owned
+    // one only resumes fill for the export
+    if (!sharedNotOwnedMatrix_->isFillComplete())
+      sharedNotOwnedMatrix_->fillComplete(params);
+
+    if (ownedMatrix_->isFillComplete())
+      ownedMatrix_->resumeFill();
+    ownedMatrix_->doExport(*sharedNotOwnedMatrix_, *exporter_, Tpetra::ADD);
+    ownedMatrix_->fillComplete(params);
+
+    ownedRhs_->doExport(*sharedNotOwnedRhs_, *exporter_, Tpetra::ADD);
+
+    lhsAssembled_ = true;
+    return;
+  }
+
   if (do_params)
     sharedNotOwnedMatrix_->fillComplete(params);
   else
@@ -1684,6 +2858,170 @@ TpetraLinearSystem::loadComplete()
 
   // RHS
   ownedRhs_->doExport(*sharedNotOwnedRhs_, *exporter_, Tpetra::ADD);
+
+  lhsAssembled_ = true;
+}
+
+void
+TpetraLinearSystem::beginLoadComplete()
+{
+  // these keep the Tpetra export of loadComplete
+  if (matrixFree_ || blockCrs_ || rhsOnly_)
+    return;
+
+  if (!sharedRowExport_.built)
+    build_shared_row_export();
+
+  SharedRowExport & plan = sharedRowExport_;
+  MPI_Comm comm = realm_.bulk_data().parallel();
+  const int tag = 2207;
+
+  size_t numRequests = 0;
+  for (size_t k = 0; k < plan.recvProcs.size(); ++k) {
+    const size_t begin = plan.recvRowStart[k] + plan.recvEntryStart[k];
+    const size_t end = plan.recvRowStart[k+1] + plan.recvEntryStart[k+1];
+    MPI_Irecv(plan.recvBuffer.data() + begin, end - begin, MPI_DOUBLE,
+              plan.recvProcs[k], tag, comm, &plan.requests[numRequests++]);
+  }
+
+  const double * const sharedNotOwnedValues = sharedNotOwnedLocalMatrix_.values.data();
+  for (size_t k = 0; k < plan.sendProcs.size(); ++k) {
+    const size_t begin = plan.sendRowStart[k] + plan.sendEntryStart[k];
+    const size_t end = plan.sendRowStart[k+1] + plan.sendEntryStart[k+1];
+    double * msg = plan.sendBuffer.data() + begin;
+    for (size_t r = plan.sendRowStart[k]; r < plan.sendRowStart[k+1]; ++r) {
+      *msg++ = sharedNotOwnedLocalRhs_(plan.sendRows[r], 0);
+    }
+    for (size_t r = plan.sendRowStart[k]; r < plan.sendRowStart[k+1]; ++r) {
+      const LocalOrdinal localRow = plan.sendRows[r];
+      for (size_t j = sharedNotOwnedLocalMatrix_.graph.row_map(localRow); j < sharedNotOwnedLocalMatrix_.graph.row_map(localRow+1); ++j) {
+        *msg++ = sharedNotOwnedValues[j];
+      }
+    }
+    MPI_Isend(plan.sendBuffer.data() + begin, end - begin, MPI_DOUBLE,
+              plan.sendProcs[k], tag, comm, &plan.requests[numRequests++]);
+  }
+
+  plan.inFlight = true;
+}
+
+void
+TpetraLinearSystem::end_shared_row_export()
+{
+  SharedRowExport & plan = sharedRowExport_;
+  MPI_Waitall(plan.requests.size(), plan.requests.data(), MPI_STATUSES_IGNORE);
+
+  double * const ownedValues = ownedLocalMatrix_.values.data();
+  for (size_t k = 0; k < plan.recvProcs.size(); ++k) {
+    const double * msg = plan.recvBuffer.data() + plan.recvRowStart[k] + plan.recvEntryStart[k];
+    for (size_t r = plan.recvRowStart[k]; r < plan.recvRowStart[k+1]; ++r) {
+      ownedLocalRhs_(plan.recvRows[r], 0) += *msg++;
+    }
+    for (size_t e = plan.recvEntryStart[k]; e < plan.recvEntryStart[k+1]; ++e) {
+      ownedValues[plan.recvOffsets[e]] += *msg++;
+    }
+  }
+
+  plan.inFlight = false;
+}
+
+void
+TpetraLinearSystem::build_shared_row_export()
+{
+  stk::mesh::BulkData & bulkData = realm_.bulk_data();
+  SharedRowExport & plan = sharedRowExport_;
+  plan = SharedRowExport();
+  plan.built = true;
+
+  // the sharedNotOwned rows and their owners; the two row maps have no gid in common
+  ThrowRequire(exporter_->getNumSameIDs() == 0 && exporter_->getNumPermuteIDs() == 0);
+  Teuchos::ArrayView<const LocalOrdinal> exportLids = exporter_->getExportLIDs();
+  Teuchos::ArrayView<const int> exportPids = exporter_->getExportPIDs();
+
+  std::vector<size_t> order(exportLids.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(),
+                   [&](size_t a, size_t b) { return exportPids[a] < exportPids[b]; });
+
+  const LinSys::Matrix::local_matrix_type & sharedMatrix = sharedNotOwnedLocalMatrix_;
+  size_t numSendEntries = 0;
+  for (size_t i : order) {
+    const int pid = exportPids[i];
+    if (plan.sendProcs.empty() || plan.sendProcs.back() != pid) {
+      plan.sendProcs.push_back(pid);
+      plan.sendRowStart.push_back(plan.sendRows.size());
+      plan.sendEntryStart.push_back(numSendEntries);
+    }
+    const LocalOrdinal localRow = exportLids[i];
+    plan.sendRows.push_back(localRow);
+    numSendEntries += sharedMatrix.graph.row_map(localRow+1) - sharedMatrix.graph.row_map(localRow);
+  }
+  plan.sendRowStart.push_back(plan.sendRows.size());
+  plan.sendEntryStart.push_back(numSendEntries);
+
+  // row and column gids of the sent rows; the owner finds them in its owned rows
+  std::vector<int> neighborProcs;
+  fill_neighbor_procs(neighborProcs, bulkData, realm_);
+  stk::CommNeighbors commNeighbors(bulkData.parallel(), neighborProcs);
+
+  for (size_t k = 0; k < plan.sendProcs.size(); ++k) {
+    stk::CommBufferV & sbuf = commNeighbors.send_buffer(plan.sendProcs[k]);
+    for (size_t r = plan.sendRowStart[k]; r < plan.sendRowStart[k+1]; ++r) {
+      const LocalOrdinal localRow = plan.sendRows[r];
+      const size_t rowBegin = sharedMatrix.graph.row_map(localRow);
+      const size_t rowEnd = sharedMatrix.graph.row_map(localRow+1);
+      const GlobalOrdinal rowGid = sharedNotOwnedRowsMap_->getGlobalElement(localRow);
+      const unsigned numCols = rowEnd - rowBegin;
+      sbuf.pack(rowGid);
+      sbuf.pack(numCols);
+      for (size_t j = rowBegin; j < rowEnd; ++j) {
+        const GlobalOrdinal colGid = totalColsMap_->getGlobalElement(sharedMatrix.graph.entries(j));
+        sbuf.pack(colGid);
+      }
+    }
+  }
+
+  commNeighbors.communicate();
+
+  const LinSys::Matrix::local_matrix_type & ownedMatrix = ownedLocalMatrix_;
+  for (int p : neighborProcs) {
+    stk::CommBufferV & rbuf = commNeighbors.recv_buffer(p);
+    if (rbuf.size_in_bytes() == 0) {
+      continue;
+    }
+    plan.recvProcs.push_back(p);
+    plan.recvRowStart.push_back(plan.recvRows.size());
+    plan.recvEntryStart.push_back(plan.recvOffsets.size());
+    while (rbuf.size_in_bytes() > 0) {
+      GlobalOrdinal rowGid = 0;
+      rbuf.unpack(rowGid);
+      unsigned numCols = 0;
+      rbuf.unpack(numCols);
+      const LocalOrdinal localRow = ownedRowsMap_->getLocalElement(rowGid);
+      ThrowRequireMsg(localRow >= 0, "TpetraLinearSystem: row gid " << rowGid << " sent from proc " << p << " is not owned");
+      plan.recvRows.push_back(localRow);
+
+      const LocalOrdinal * rowBegin = ownedMatrix.graph.entries.data() + ownedMatrix.graph.row_map(localRow);
+      const LocalOrdinal * rowEnd = ownedMatrix.graph.entries.data() + ownedMatrix.graph.row_map(localRow+1);
+      for (unsigned j = 0; j < numCols; ++j) {
+        GlobalOrdinal colGid = 0;
+        rbuf.unpack(colGid);
+        const LocalOrdinal colLid = totalColsMap_->getLocalElement(colGid);
+        const LocalOrdinal * found = std::lower_bound(rowBegin, rowEnd, colLid);
+        ThrowRequireMsg(colLid >= 0 && found != rowEnd && *found == colLid,
+                        "TpetraLinearSystem: column gid " << colGid << " of row gid " << rowGid << " is not in the owned graph");
+        plan.recvOffsets.push_back(found - ownedMatrix.graph.entries.data());
+      }
+    }
+  }
+  plan.recvRowStart.push_back(plan.recvRows.size());
+  plan.recvEntryStart.push_back(plan.recvOffsets.size());
+
+  plan.sendBuffer.resize(plan.sendRows.size() + numSendEntries);
+  plan.recvBuffer.resize(plan.recvRows.size() + plan.recvOffsets.size());
+  plan.requests.resize(plan.sendProcs.size() + plan.recvProcs.size());
 }
 
 int
@@ -1693,14 +3031,14 @@ TpetraLinearSystem::solve(
 
   TpetraLinearSolver *linearSolver = reinterpret_cast<TpetraLinearSolver *>(linearSolver_);
 
-  if ( realm_.debug() ) {
+  if ( realm_.debug() && !matrixFree_ && !blockCrs_ ) {
     checkForNaN(true);
     if (checkForZeroRow(true, false, true)) {
       throw std::runtime_error("ERROR checkForZeroRow in solve()");
     }
   }
    
-  if (linearSolver->getConfig()->getWriteMatrixFiles()) {
+  if (linearSolver->getConfig()->getWriteMatrixFiles() && !matrixFree_ && !blockCrs_) {
     writeToFile(eqSysName_.c_str());
     writeToFile(eqSysName_.c_str(), false);
   }
@@ -1716,6 +3054,20 @@ TpetraLinearSystem::solve(
     realm_.provide_memory_summary();
   }
 
+  linearSolver->set_matrix_unchanged(rhsOnly_);
+
+  // the k-th solve of a time step is predicted from the k-th solves of the
+  // earlier steps; steady runs have a single slot
+  size_t guessSlot = 0;
+  if ( realm_.simType_ == "transient" ) {
+    if ( realm_.get_time_step_count() != guessTimeStep_ ) {
+      guessTimeStep_ = realm_.get_time_step_count();
+      solvesInTimeStep_ = 0;
+    }
+    guessSlot = solvesInTimeStep_++;
+  }
+  linearSolver->set_initial_guess_slot(guessSlot);
+
   const int status = linearSolver->solve(
       sln_,
       iters,
@@ -1724,7 +3076,7 @@ TpetraLinearSystem::solve(
 
   solve_time += HOFlowEnv::self().hoflow_time();
 
-  if (linearSolver->getConfig()->getWriteMatrixFiles()) {
+  if (linearSolver->getConfig()->getWriteMatrixFiles() && !matrixFree_ && !blockCrs_) {
     writeSolutionToFile(eqSysName_.c_str());
     ++writeCounter_;
   }
@@ -1739,6 +3091,8 @@ TpetraLinearSystem::solve(
   linearSolveIterations_ = iters;
   nonLinearResidual_ = realm_.l2Scaling_*norm2;
   linearResidual_ = finalResidNorm;
+  initialGuessActive_ = linearSolver->initial_guess_active();
+  initialGuessResidual_ = linearSolver->initial_guess_residual_ratio();
    
   if ( eqSys_->firstTimeStepSolve_ )
     firstNonLinearResidual_ = nonLinearResidual_;
@@ -1804,11 +3158,11 @@ TpetraLinearSystem::checkForZeroRow(bool useOwned, bool doThrow, bool doPrint)
   size_t nrowG = matrix->getRangeMap()->getGlobalNumElements();
   size_t n = matrix->getRowMap()->getNodeNumElements();
   GlobalOrdinal max_gid = 0, g_max_gid=0;
-  //KOKKOS: Loop parallel reduce
-  kokkos_parallel_for("Nalu::TpetraLinearSystem::checkForZeroRowA", n, [&] (const size_t& i) {
+  Kokkos::Max<GlobalOrdinal> maxGidReducer(max_gid);
+  kokkos_parallel_reduce(n, [&] (const size_t& i, GlobalOrdinal& localMax) {
     GlobalOrdinal gid = matrix->getGraph()->getRowMap()->getGlobalElement(i);
-    max_gid = std::max(gid, max_gid);
-  });
+    localMax = std::max(gid, localMax);
+  }, maxGidReducer, "Nalu::TpetraLinearSystem::checkForZeroRowA");
   stk::all_reduce_max(bulkData.parallel(), &max_gid, &g_max_gid, 1);
 
   nrowG = g_max_gid+1;
@@ -1837,8 +3191,8 @@ TpetraLinearSystem::checkForZeroRow(bool useOwned, bool doThrow, bool doPrint)
   stk::all_reduce_max(bulkData.parallel(), &local_row_exists[0], &global_row_exists[0], (unsigned)nrowG);
 
   bool found=false;
-  //KOKKOS: Loop parallel
-  kokkos_parallel_for("Nalu::TpetraLinearSystem::checkForZeroRowC", nrowG, [&] (const size_t& ii) {
+  // serial on purpose; the loop prints diagnostics and sets found
+  for ( size_t ii = 0; ii < nrowG; ++ii ) {
     double row_sum = global_row_sums[ii];
     if (global_row_exists[ii] && bulkData.parallel_rank() == 0 && row_sum < 1.e-10) {
       found = true;
@@ -1870,7 +3224,7 @@ TpetraLinearSystem::checkForZeroRow(bool useOwned, bool doThrow, bool doPrint)
                         << std::endl;
       }
     }
-  });
+  }
 
   if (found && doThrow) {
     throw std::runtime_error("bad zero row LHS");
@@ -49,9 +49,10 @@ int main(int argc, char** argv) {
     std::string inputFileName, logFileName;
     
     
-    // start up MPI
-    if ( MPI_SUCCESS != MPI_Init( &argc , &argv ) ) {
-        throw std::runtime_error("MPI_Init failed");
+    // start up MPI; output may be written on a second thread that makes no MPI calls
+    int threadSupport = MPI_THREAD_SINGLE;
+    if ( MPI_SUCCESS != MPI_Init_thread( &argc , &argv, MPI_THREAD_FUNNELED, &threadSupport ) ) {
+        throw std::runtime_error("MPI_Init_thread failed");
     }
     
     // HOFlowEnv singleton
@@ -0,0 +1,104 @@
+/*------------------------------------------------------------------------*/
+/*  HOFlow - Higher Order Flow                                            */
+/*  CFD Solver based ond CVFEM                                            */
+/*------------------------------------------------------------------------*/
+#include "kernel/ScalarDiffElemKernel.h"
+#include "AlgTraits.h"
+#include "master_element/MasterElement.h"
+#include "SolutionOptions.h"
+
+// template and scratch space
+#include "BuildTemplates.h"
+#include "ScratchViews.h"
+
+// stk_mesh/base/fem
+#include <stk_mesh/base/Entity.hpp>
+#include <stk_mesh/base/MetaData.hpp>
+#include <stk_mesh/base/BulkData.hpp>
+#include <stk_mesh/base/Field.hpp>
+
+template<typename AlgTraits>
+ScalarDiffElemKernel<AlgTraits>::ScalarDiffElemKernel(
+  const stk::mesh::BulkData& bulkData,
+  const SolutionOptions& solnOpts,
+  ScalarFieldType* scalarQ,
+  ScalarFieldType* diffFluxCoeff,
+  ElemDataRequests& dataPreReqs)
+  : Kernel(),
+    scalarQ_(scalarQ),
+    diffFluxCoeff_(diffFluxCoeff),
+    lrscv_(MasterElementRepo::get_surface_master_element(AlgTraits::topo_)->adjacentNodes()),
+    shiftedGradOp_(solnOpts.get_shifted_grad_op(scalarQ->name()))
+{
+  const stk::mesh::MetaData& metaData = bulkData.mesh_meta_data();
+  coordinates_ = metaData.get_field<VectorFieldType>(stk::topology::NODE_RANK, solnOpts.get_coordinates_name());
+
+  MasterElement *meSCS = MasterElementRepo::get_surface_master_element(AlgTraits::topo_);
+  get_scs_shape_fn_data<AlgTraits>([&](double* ptr){meSCS->shape_fcn(ptr);}, v_shape_function_);
+
+  // add master elements
+  dataPreReqs.add_cvfem_surface_me(meSCS);
+
+  // fields and data
+  dataPreReqs.add_coordinates_field(*coordinates_, AlgTraits::nDim_, CURRENT_COORDINATES);
+  dataPreReqs.add_gathered_nodal_field(*scalarQ_, 1);
+  dataPreReqs.add_gathered_nodal_field(*diffFluxCoeff_, 1);
+  dataPreReqs.add_master_element_call(SCS_AREAV, CURRENT_COORDINATES);
+  if ( shiftedGradOp_ )
+    dataPreReqs.add_master_element_call(SCS_SHIFTED_GRAD_OP, CURRENT_COORDINATES);
+  else
+    dataPreReqs.add_master_element_call(SCS_GRAD_OP, CURRENT_COORDINATES);
+}
+
+template<typename AlgTraits>
+ScalarDiffElemKernel<AlgTraits>::~ScalarDiffElemKernel()
+{}
+
+template<typename AlgTraits>
+void
+ScalarDiffElemKernel<AlgTraits>::execute(
+  SharedMemView<DoubleType**>& lhs,
+  SharedMemView<DoubleType*>& rhs,
+  ScratchViews<DoubleType>& scratchViews)
+{
+  SharedMemView<DoubleType*>& v_scalarQ = scratchViews.get_scratch_view_1D(*scalarQ_);
+  SharedMemView<DoubleType*>& v_diffFluxCoeff = scratchViews.get_scratch_view_1D(*diffFluxCoeff_);
+
+  SharedMemView<DoubleType**>& v_scs_areav = scratchViews.get_me_views(CURRENT_COORDINATES).scs_areav;
+  SharedMemView<DoubleType***>& v_dndx = shiftedGradOp_
+    ? scratchViews.get_me_views(CURRENT_COORDINATES).dndx_shifted
+    : scratchViews.get_me_views(CURRENT_COORDINATES).dndx;
+
+  for ( int ip = 0; ip < AlgTraits::numScsIp_; ++ip ) {
+
+    // left and right nodes for this ip
+    const int il = lrscv_[2*ip];
+    const int ir = lrscv_[2*ip+1];
+
+    // interpolate diffusion coefficient to the ip
+    DoubleType diffFluxCoeffIp = 0.0;
+    for ( int ic = 0; ic < AlgTraits::nodesPerElement_; ++ic ) {
+      diffFluxCoeffIp += v_shape_function_(ip,ic)*v_diffFluxCoeff(ic);
+    }
+
+    DoubleType qDiff = 0.0;
+    for ( int ic = 0; ic < AlgTraits::nodesPerElement_; ++ic ) {
+      DoubleType lhsfacDiff = 0.0;
+      for ( int j = 0; j < AlgTraits::nDim_; ++j ) {
+        lhsfacDiff += -diffFluxCoeffIp*v_dndx(ip,ic,j)*v_scs_areav(ip,j);
+      }
+
+      qDiff += lhsfacDiff*v_scalarQ(ic);
+
+      // lhs; il then ir
+      lhs(il,ic) += lhsfacDiff;
+      lhs(ir,ic) -= lhsfacDiff;
+    }
+
+    // rhs; il then ir
+    rhs(il) -= qDiff;
+    rhs(ir) += qDiff;
+  }
+}
+
+INSTANTIATE_KERNEL_CVFEM_P1(ScalarDiffElemKernel);
@@ -240,6 +240,34 @@ void TetSCV::determinant(
       volume, error, &lerr );
 }
 
+//--------------------------------------------------------------------------
+//-------- batch_determinant -----------------------------------------------
+//--------------------------------------------------------------------------
+void TetSCV::batch_determinant(
+  const int nelem,
+  const double *coords,
+  double *volume)
+{
+  // the four subcontrol volumes of a linear tet are a quarter of it each
+  const double one24th = 1.0/24.0;
+
+  for ( int e = 0; e < nelem; ++e ) {
+    const double *x = coords + 12*e;
+
+    const double ax = x[3] - x[0], ay = x[4] - x[1], az = x[5] - x[2];
+    const double bx = x[6] - x[0], by = x[7] - x[1], bz = x[8] - x[2];
+    const double cx = x[9] - x[0], cy = x[10] - x[1], cz = x[11] - x[2];
+
+    const double scv = one24th*( ax*(by*cz - bz*cy) + ay*(bz*cx - bx*cz) + az*(bx*cy - by*cx) );
+
+    double *vol = volume + 4*e;
+    vol[0] = scv;
+    vol[1] = scv;
+    vol[2] = scv;
+    vol[3] = scv;
+  }
+}
+
 //--------------------------------------------------------------------------
 //-------- shape_fcn -------------------------------------------------------
 //--------------------------------------------------------------------------
@@ -555,6 +583,123 @@ void TetSCS::determinant(
   *error = 0;
 }
 
+//--------------------------------------------------------------------------
+//-------- batch_determinant -----------------------------------------------
+//--------------------------------------------------------------------------
+void TetSCS::batch_determinant(
+  const int nelem,
+  const double *coords,
+  double *areav)
+{
+  // the vector area of a quad only depends on its boundary; for the quad
+  // (p1,p2,p3,p4) of tetEdgeFacetTable it is 0.5*(p3-p1)x(p4-p2), the same
+  // as the triangle facets of quadAreaByTriangleFacets
+  const double half = 0.5;
+  const double one3rd = 1.0/3.0;
+  const double one4th = 1.0/4.0;
+
+  for ( int e = 0; e < nelem; ++e ) {
+    const double *x0 = coords + 12*e;
+    const double *x1 = x0 + 3;
+    const double *x2 = x0 + 6;
+    const double *x3 = x0 + 9;
+    double *av = areav + 18*e;
+
+    // edge midpoints, face midpoints and centroid
+    double m01[3], m12[3], m02[3], m03[3], m13[3], m23[3];
+    double f012[3], f123[3], f023[3], f013[3], c[3];
+    for ( int k = 0; k < 3; ++k ) {
+      m01[k] = half*(x0[k] + x1[k]);
+      m12[k] = half*(x1[k] + x2[k]);
+      m02[k] = half*(x0[k] + x2[k]);
+      m03[k] = half*(x0[k] + x3[k]);
+      m13[k] = half*(x1[k] + x3[k]);
+      m23[k] = half*(x2[k] + x3[k]);
+      f012[k] = one3rd*(x0[k] + x1[k] + x2[k]);
+      f123[k] = one3rd*(x1[k] + x2[k] + x3[k]);
+      f023[k] = one3rd*(x0[k] + x2[k] + x3[k]);
+      f013[k] = one3rd*(x0[k] + x1[k] + x3[k]);
+      c[k] = one4th*(x0[k] + x1[k] + x2[k] + x3[k]);
+    }
+
+    // diagonals (p3-p1) and (p4-p2) of each scs
+    double d1[6][3], d2[6][3];
+    for ( int k = 0; k < 3; ++k ) {
+      d1[0][k] = c[k] - m01[k];     d2[0][k] = f013[k] - f012[k];
+      d1[1][k] = f123[k] - f012[k]; d2[1][k] = m12[k] - c[k];
+      d1[2][k] = c[k] - m02[k];     d2[2][k] = f012[k] - f023[k];
+      d1[3][k] = c[k] - m03[k];     d2[3][k] = f023[k] - f013[k];
+      d1[4][k] = f123[k] - f013[k]; d2[4][k] = c[k] - m13[k];
+      d1[5][k] = f023[k] - f123[k]; d2[5][k] = c[k] - m23[k];
+    }
+
+    for ( int ics = 0; ics < 6; ++ics ) {
+      av[3*ics+0] = half*(d1[ics][1]*d2[ics][2] - d1[ics][2]*d2[ics][1]);
+      av[3*ics+1] = half*(d1[ics][2]*d2[ics][0] - d1[ics][0]*d2[ics][2]);
+      av[3*ics+2] = half*(d1[ics][0]*d2[ics][1] - d1[ics][1]*d2[ics][0]);
+    }
+  }
+}
+
+//--------------------------------------------------------------------------
+//-------- batch_grad_op ---------------------------------------------------
+//--------------------------------------------------------------------------
+int TetSCS::batch_grad_op(
+  const int nelem,
+  const double *coords,
+  double *gradop,
+  double *det_j)
+{
+  // linear tet; the Jacobian and gradient operator are constant in the
+  // element (tet_gradient_operator with the tet_derivative values)
+  const double realmin = std::numeric_limits<double>::min();
+  const int nscs = 6;
+  int nerr = 0;
+
+  for ( int e = 0; e < nelem; ++e ) {
+    const double *x = coords + 12*e;
+
+    const double dx_ds1 = x[3] - x[0], dx_ds2 = x[6] - x[0], dx_ds3 = x[9] - x[0];
+    const double dy_ds1 = x[4] - x[1], dy_ds2 = x[7] - x[1], dy_ds3 = x[10] - x[1];
+    const double dz_ds1 = x[5] - x[2], dz_ds2 = x[8] - x[2], dz_ds3 = x[11] - x[2];
+
+    const double det = dx_ds1*( dy_ds2*dz_ds3 - dz_ds2*dy_ds3 )
+                     + dy_ds1*( dz_ds2*dx_ds3 - dx_ds2*dz_ds3 )
+                     + dz_ds1*( dx_ds2*dy_ds3 - dy_ds2*dx_ds3 );
+
+    // same protection as the Fortran kernel
+    const bool bad = det <= 1.0e6*realmin;
+    nerr += bad ? 1 : 0;
+    const double denom = bad ? 1.0 : 1.0/det;
+
+    const double ds1_dx = denom*(dy_ds2*dz_ds3 - dz_ds2*dy_ds3);
+    const double ds2_dx = denom*(dz_ds1*dy_ds3 - dy_ds1*dz_ds3);
+    const double ds3_dx = denom*(dy_ds1*dz_ds2 - dz_ds1*dy_ds2);
+
+    const double ds1_dy = denom*(dz_ds2*dx_ds3 - dx_ds2*dz_ds3);
+    const double ds2_dy = denom*(dx_ds1*dz_ds3 - dz_ds1*dx_ds3);
+    const double ds3_dy = denom*(dz_ds1*dx_ds2 - dx_ds1*dz_ds2);
+
+    const double ds1_dz = denom*(dx_ds2*dy_ds3 - dy_ds2*dx_ds3);
+    const double ds2_dz = denom*(dy_ds1*dx_ds3 - dx_ds1*dy_ds3);
+    const double ds3_dz = denom*(dx_ds1*dy_ds2 - dy_ds1*dx_ds2);
+
+    const double g[12] = {
+      -(ds1_dx + ds2_dx + ds3_dx), -(ds1_dy + ds2_dy + ds3_dy), -(ds1_dz + ds2_dz + ds3_dz),
+      ds1_dx, ds1_dy, ds1_dz,
+      ds2_dx, ds2_dy, ds2_dz,
+      ds3_dx, ds3_dy, ds3_dz };
+
+    double *gop = gradop + e*nscs*12;
+    for ( int ip = 0; ip < nscs; ++ip ) {
+      for ( int n = 0; n < 12; ++n )
+        gop[ip*12+n] = g[n];
+      det_j[e*nscs+ip] = det;
+    }
+  }
+  return nerr;
+}
+
 //--------------------------------------------------------------------------
 //-------- grad_op ---------------------------------------------------------
 //--------------------------------------------------------------------------
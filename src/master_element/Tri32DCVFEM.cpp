@@ -525,6 +525,84 @@ void Tri32DSCS::determinant(
   *error = 0;
 }
 
+//--------------------------------------------------------------------------
+//-------- batch_determinant -----------------------------------------------
+//--------------------------------------------------------------------------
+void Tri32DSCS::batch_determinant(
+  const int nelem,
+  const double *coords,
+  double *areav)
+{
+  // Cartesian tri_scs_det; each scs runs from the centroid to an edge midpoint
+  const double half = 0.5;
+  const double one3rd = 1.0/3.0;
+
+  for ( int e = 0; e < nelem; ++e ) {
+    const double *x = coords + 6*e;
+    double *av = areav + 6*e;
+
+    const double xc = one3rd*(x[0] + x[2] + x[4]);
+    const double yc = one3rd*(x[1] + x[3] + x[5]);
+
+    const double x01 = half*(x[0] + x[2]), y01 = half*(x[1] + x[3]);
+    const double x12 = half*(x[2] + x[4]), y12 = half*(x[3] + x[5]);
+    const double x20 = half*(x[4] + x[0]), y20 = half*(x[5] + x[1]);
+
+    av[0] = -(y01 - yc);
+    av[1] =  (x01 - xc);
+    av[2] = -(y12 - yc);
+    av[3] =  (x12 - xc);
+    av[4] =  (y20 - yc);
+    av[5] = -(x20 - xc);
+  }
+}
+
+//--------------------------------------------------------------------------
+//-------- batch_grad_op ---------------------------------------------------
+//--------------------------------------------------------------------------
+int Tri32DSCS::batch_grad_op(
+  const int nelem,
+  const double *coords,
+  double *gradop,
+  double *det_j)
+{
+  // linear tri; constant Jacobian (tri_gradient_operator with tri_derivative)
+  const double realmin = std::numeric_limits<double>::min();
+  const int nscs = 3;
+  int nerr = 0;
+
+  for ( int e = 0; e < nelem; ++e ) {
+    const double *x = coords + 6*e;
+
+    const double dx_ds1 = x[2] - x[0], dx_ds2 = x[4] - x[0];
+    const double dy_ds1 = x[3] - x[1], dy_ds2 = x[5] - x[1];
+
+    const double det = dx_ds1*dy_ds2 - dy_ds1*dx_ds2;
+
+    const bool bad = det <= 1.0e6*realmin;
+    nerr += bad ? 1 : 0;
+    const double denom = bad ? 1.0 : 1.0/det;
+
+    const double ds1_dx =  denom*dy_ds2;
+    const double ds2_dx = -denom*dy_ds1;
+    const double ds1_dy = -denom*dx_ds2;
+    const double ds2_dy =  denom*dx_ds1;
+
+    const double g[6] = {
+      -(ds1_dx + ds2_dx), -(ds1_dy + ds2_dy),
+      ds1_dx, ds1_dy,
+      ds2_dx, ds2_dy };
+
+    double *gop = gradop + e*nscs*6;
+    for ( int ip = 0; ip < nscs; ++ip ) {
+      for ( int n = 0; n < 6; ++n )
+        gop[ip*6+n] = g[n];
+      det_j[e*nscs+ip] = det;
+    }
+  }
+  return nerr;
+}
+
 //--------------------------------------------------------------------------
 //-------- grad_op ---------------------------------------------------------
 //--------------------------------------------------------------------------